@@ -3,9 +3,50 @@
 
 #include <pugixml.hpp>
 #include "Common.h"
+#include "EntityRef.h"
+#include "SerialWriter.h"
 
 namespace SBURB
 {
+    // An action's arguments, split and parsed once when the action is made.
+    // Clones share them, so repeating an action does no string work.
+    class ActionArgs
+    {
+    public:
+        ActionArgs(const std::string &info = "");
+
+        // The whole argument string, trimmed
+        const std::string &GetText() const { return this->text; };
+
+        size_t Size() const { return this->params.size(); };
+        // Missing parameters read as empty or zero
+        const std::string &Get(size_t index) const;
+        int GetInt(size_t index) const;
+        float GetFloat(size_t index) const;
+        bool GetBool(size_t index) const { return this->Get(index) == "true"; };
+        // A parameter naming a sprite ("char" for the player) or a room, bound the first time it's asked for
+        std::shared_ptr<Sprite> GetSprite(size_t index) const;
+        std::shared_ptr<Room> GetRoom(size_t index) const;
+        // Everything from a parameter to the end, commas included
+        std::string GetFrom(size_t index) const;
+
+    private:
+        struct Param
+        {
+            std::string value;
+            int number;
+            float real;
+            size_t offset;
+
+            // Only the bindings change after parsing, and only to cache a lookup
+            mutable SpriteRef sprite;
+            mutable RoomRef room;
+        };
+
+        std::string text;
+        std::vector<Param> params;
+    };
+
     class Action
     {
     public:
@@ -13,7 +54,7 @@ namespace SBURB
         ~Action();
 
         std::shared_ptr<Action> Clone();
-        std::string Serialize(std::string output);
+        void Serialize(SerialWriter &out);
 
         void SetFollowUp(std::shared_ptr<Action> followUp) { this->followUp = followUp; };
       
@@ -24,6 +65,8 @@ namespace SBURB
         int GetTimes() { return this->times; };
 
         std::string GetCommand() { return this->command; };
+        uint32_t GetCommandId() { return this->commandId; };
+        const ActionArgs &GetArgs() { return *this->args; };
 
         void SetSoft(bool soft) { this->soft = soft; };
         bool GetSoft() { return this->soft; };
@@ -54,6 +97,8 @@ namespace SBURB
         std::string sprite;
         std::string name;
         std::string command;
+        uint32_t commandId;
+        std::shared_ptr<const ActionArgs> args;
         bool noWait;
         bool noDelay;
         uint16_t times;
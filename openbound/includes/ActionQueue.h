@@ -5,6 +5,7 @@
 #include "Common.h"
 #include "Action.h"
 #include "Trigger.h"
+#include "Signals.h"
 
 namespace SBURB
 {
@@ -15,9 +16,9 @@ namespace SBURB
         ~ActionQueue();
 
         bool HasGroup(std::string group);
-        std::string Serialize(std::string output);
+        void Serialize(SerialWriter &out);
 
-        void SetCurrentAction(std::shared_ptr<Action> curAction) { this->curAction = curAction; }
+        void SetCurrentAction(std::shared_ptr<Action> curAction) { this->curAction = curAction; Signals::Publish(SignalQueues); }
         std::shared_ptr<Action> GetCurrentAction() { return this->curAction; };
 
         std::string GetId() { return this->id; };
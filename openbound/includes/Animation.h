@@ -3,6 +3,7 @@
 
 #include "Common.h"
 #include "AssetGraphic.h"
+#include "SerialWriter.h"
 
 namespace SBURB
 {
@@ -17,7 +18,9 @@ namespace SBURB
 
         void Reset();
         bool HasPlayed();
+		bool IsStatic() { return this->length <= 1; };
         bool IsVisuallyUnder(int x, int y);
+		sf::FloatRect GetBounds() const;
 
         void SetColSize(int newSize);
 		int GetColSize() { return this->colSize; };
@@ -38,14 +41,17 @@ namespace SBURB
 		int GetFrameInterval() { return this->frameInterval; };
 
 		std::shared_ptr<AssetGraphic> GetSheet() { return this->sheet; };
+		// Every graphic this animation draws from, the slices too
+		void CollectSheets(std::vector<std::shared_ptr<Asset>>& sheets);
 
 		std::string GetFollowUp() { return this->followUp; };
 
         std::shared_ptr<Animation> Clone(int x = 0, int y = 0);
 
-        std::string Serialize(std::string output);
+        void Serialize(SerialWriter &out);
 
 		std::string GetName() { return this->name; };
+		int GetCurrentFrame() { return this->curFrame; };
 
     protected:
 		std::string sheetName;
@@ -67,7 +73,8 @@ namespace SBURB
 		bool flipY;
 		int numRows;
 		int numCols;
-		std::map<int, std::map<int, std::shared_ptr<AssetGraphic>>> sheets;
+		// Sliced tiles, indexed by colNum * numRows + rowNum. Missing tiles are null.
+		std::vector<std::shared_ptr<AssetGraphic>> sheets;
 		std::map<int, int> frameIntervals;
 		int frameInterval;
 
@@ -2,16 +2,50 @@
 #define SBURB_ASSET_H
 
 #include <string>
+#include <cstdint>
 
 namespace SBURB {
     class Asset {
     public:
+        virtual ~Asset() {};
+
         std::string GetType() { return this->type; };
         std::string GetName() { return this->name; };
 
+        // Loading happens in two steps so the slow part can run on a loader thread.
+        // Decode reads and decodes the file and must not touch the GPU, Upload then runs on the main thread.
+        virtual bool Decode() { return true; };
+        virtual void Upload() {};
+
+        // Turns file names into full paths against the resource path. Called on the main thread when the asset
+        // is queued, the resource path changes with every file loaded and Decode only reads what was resolved here.
+        virtual void ResolvePaths() {};
+
+        bool IsLoaded() { return this->loaded; };
+        void SetLoaded(bool loaded) { this->loaded = loaded; };
+
+        // Residency. Assets that can be read back from disk may be evicted to save memory and
+        // reload themselves the next time they are used. Pinned assets are never evicted.
+        virtual size_t GetResidentSize() { return 0; };
+        // False if the asset is still in use and has to stay
+        virtual bool Evict() { return false; };
+
+        void Touch() { this->lastUsed = ++useClock; };
+        uint64_t GetLastUsed() { return this->lastUsed; };
+
+        void Pin() { this->pins++; };
+        void Unpin() { if (this->pins > 0) this->pins--; };
+        bool IsPinned() { return this->pins > 0; };
+
     protected:
         std::string type;
         std::string name;
+        bool loaded = true;
+
+        uint64_t lastUsed = 0;
+        int pins = 0;
+
+        inline static uint64_t useClock = 0;
     };
 }
 #endif
\ No newline at end of file
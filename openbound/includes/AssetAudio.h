@@ -12,13 +12,22 @@ namespace SBURB
     public:
         AssetAudio(std::string name, std::vector<std::string> sources);
 
-        std::shared_ptr<sf::SoundBuffer> GetAsset() { return this->asset; };
+        bool Decode() override;
+        void ResolvePaths() override;
+
+        size_t GetResidentSize() override;
+        bool Evict() override;
+
+        // Reloads the samples first if they were evicted
+        std::shared_ptr<sf::SoundBuffer> GetAsset();
 
         std::vector<std::string> GetSources() { return this->sources; };
 
     private:
         std::vector<std::string> sources;
+        std::string resolvedSource;
         std::shared_ptr<sf::SoundBuffer> asset;
+        bool resident;
 
     };
 }
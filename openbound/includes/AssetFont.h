@@ -11,12 +11,18 @@ namespace SBURB
     public:
         AssetFont(std::string name, std::vector<std::string> sources);
 
+        // Only reads the face, glyph textures are made on demand when text is drawn
+        bool Decode() override;
+        void ResolvePaths() override;
+
         std::shared_ptr<sf::Font> GetAsset() { return this->asset; };
 
         std::vector<std::string> GetSources() { return this->sources; };
 
     private:
         std::vector<std::string> sources;
+        // Type and value of each source, url paths made full
+        std::vector<std::pair<std::string, std::string>> resolvedSources;
         std::shared_ptr<sf::Font> asset;
 
     };
@@ -3,7 +3,11 @@
 
 #include "Common.h"
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include "Asset.h"
+#include "BitMask.h"
+
+#include <atomic>
 
 namespace SBURB
 {
@@ -12,13 +16,60 @@ namespace SBURB
     public:
         AssetGraphic(std::string name, std::string path);
 
-        std::shared_ptr<sf::Texture> GetAsset() { return this->asset; };
+        bool Decode() override;
+        void Upload() override;
+        void ResolvePaths() override;
+
+        size_t GetResidentSize() override;
+        bool Evict() override;
+
+        // Reloads the texture first if it was evicted
+        std::shared_ptr<sf::Texture> GetAsset();
+        sf::Vector2u GetSize() { return this->size; };
+
+        // The texture to actually draw with, an atlas page if we were packed into one.
+        std::shared_ptr<sf::Texture> GetTexture();
+        sf::Vector2u GetAtlasOffset() { return this->atlasOffset; };
+        void SetAtlasLocation(std::shared_ptr<sf::Texture> page, sf::Vector2u offset) { this->atlasPage = page; this->atlasOffset = offset; };
+
+        // CPU side copy of the pixels, read back from the texture or straight from disk when headless.
+        sf::Image CopyToImage();
+
+        // One bit per pixel, set where the pixel is pure white. Built while loading for graphics marked
+        // walkable, decoded from disk on first use otherwise, then shared by every room that walks on it.
+        std::shared_ptr<const BitMask> GetWalkMask();
+
+        // Walkable maps are only read through their mask, the texture waits until something draws one
+        void SetWalkable() { this->walkable = true; };
+        bool IsWalkable() { return this->walkable; };
 
         std::string GetPath() { return this->path; };
 
+        int GetHandle() { return this->handle; };
+        void SetHandle(int handle) { this->handle = handle; };
+
     private:
+        void Restore();
+        void UploadTexture();
+        void BuildWalkMask(const sf::Image &image);
+
         std::string path;
+        std::string resolvedPath;
         std::shared_ptr<sf::Texture> asset;
+        sf::Vector2u size;
+        bool resident;
+
+        // Decoded pixels waiting for Upload
+        sf::Image pixels;
+
+        int handle;
+
+        std::shared_ptr<sf::Texture> atlasPage;
+        sf::Vector2u atlasOffset;
+
+        std::shared_ptr<BitMask> walkMask;
+        // Set on the main thread, read by Decode on the loader threads
+        std::atomic<bool> walkable;
 
     };
 }
@@ -0,0 +1,67 @@
+#ifndef SBURB_ASSET_LOADER_H
+#define SBURB_ASSET_LOADER_H
+
+#include "Common.h"
+#include "Asset.h"
+#include <SFML/System/Time.hpp>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace SBURB
+{
+    // Decodes assets on a small pool of threads. Decoded assets wait until the main thread
+    // pumps them through Upload, which is the only part that may talk to the GPU.
+    class AssetLoader
+    {
+    public:
+        // Singleton Initialization
+        inline static AssetLoader &getInstance()
+        {
+            static AssetLoader instance;
+            return instance;
+        }
+
+        // Delete methods we don't want
+        AssetLoader(AssetLoader const &) = delete;
+        void operator=(AssetLoader const &) = delete;
+
+        void Queue(std::shared_ptr<Asset> asset);
+
+        // Uploads decoded assets until the budget runs out, a zero budget takes everything ready.
+        // True once nothing is left in flight.
+        bool Pump(sf::Time budget);
+        // Blocks until everything queued so far is loaded
+        void Finish();
+
+        bool IsLoading();
+        // Fraction of the current batch that is done, 1 when idle
+        float GetProgress();
+        int GetLoadedCount();
+        int GetQueuedCount();
+
+    private:
+        AssetLoader();
+        ~AssetLoader();
+
+        void StartWorkers();
+        void Work();
+        void Complete(std::shared_ptr<Asset> asset);
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable jobReady;
+        std::condition_variable jobDone;
+        std::deque<std::shared_ptr<Asset>> pending;
+        std::deque<std::shared_ptr<Asset>> decoded;
+        bool stopping;
+
+        // Counts for the current batch, reset once it has fully loaded
+        int queuedCount;
+        int loadedCount;
+    };
+}
+
+#endif
@@ -16,7 +16,22 @@ namespace SBURB
     class AssetManager
     {
     public:
-        static void LoadAsset(std::shared_ptr<Asset> asset);
+        // Registers the asset by name, false if one with that name is already there
+        static bool LoadAsset(std::shared_ptr<Asset> asset);
+        // Called by the loader once an asset has been decoded and uploaded
+        static void OnAssetLoaded(std::shared_ptr<Asset> asset);
+        // Whether an asset of any type is registered under the name, loaded or still on its way
+        static bool CheckIsLoaded(const std::string &name);
+
+        // Residency
+        // Bytes of graphics and audio allowed to stay loaded beyond the pinned ones, 0 for no limit
+        static void SetMemoryBudget(size_t bytes);
+        static size_t GetMemoryBudget();
+        static size_t GetResidentSize();
+        // Swaps the pinned set for a new one, an asset stays pinned while any set holding it is
+        static void PinAssets(const std::vector<std::shared_ptr<Asset>> &assets);
+        // Evicts the least recently used unpinned assets until we fit in the budget again
+        static void EnforceBudget();
 
         // Path
         static std::shared_ptr<AssetPath> GetPathByName(const std::string &name);
@@ -24,6 +39,9 @@ namespace SBURB
 
         // Graphic
         static std::shared_ptr<AssetGraphic> GetGraphicByName(const std::string &name);
+        // Dense handles handed out at load time, for lookups on the render path
+        static int GetGraphicHandle(const std::string &name);
+        static std::shared_ptr<AssetGraphic> GetGraphicByHandle(int handle);
         static void ClearGraphics();
 
         // Audio
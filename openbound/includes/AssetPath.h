@@ -3,6 +3,7 @@
 
 #include <Common.h>
 #include "Asset.h"
+#include "BitMask.h"
 
 namespace SBURB {
     class AssetPath : public Asset {
@@ -10,10 +11,17 @@ namespace SBURB {
         AssetPath(std::string name, std::vector<Vector2> points);
 
         void Push(Vector2 point);
-        void QueryBatchPos(std::map<std::string, Vector2> queries, std::map<std::string, bool>* results);
-        void QueryBatchNeg(std::map<std::string, Vector2> queries, std::map<std::string, bool>* results);
+        // Batch tests write inside[i] for every query point. Pos ORs the path into query.results, Neg masks it out.
+        void QueryBatch(const BoundaryQuery &query, bool *inside);
+        void QueryBatchPos(BoundaryQuery &query);
+        void QueryBatchNeg(BoundaryQuery &query);
         bool Query(Vector2 point);
 
+        // Rasterize onto a mask with one bit per scale x scale cell. Interior sets cells whose centre
+        // passes Query, edges conservatively sets every cell the outline could touch.
+        void RasterizeInterior(BitMask &mask, int scale);
+        void RasterizeEdges(BitMask &mask, int scale);
+
         std::vector<Vector2> GetPoints() { return this->points; };
 
     private:
@@ -3,6 +3,11 @@
 
 #include "Common.h"
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <unordered_map>
 
 namespace SBURB
 {
@@ -21,27 +26,69 @@ namespace SBURB
         void operator=(BatchHandler const &) = delete;
 
         // Actual public method
-        void DrawSpriteRect(std::string textureName, const sf::VertexArray &coords, sf::RenderTarget &target);
+        void DrawSpriteRect(int textureHandle, const sf::VertexArray &coords, sf::RenderTarget &target);
         void DrawPrimitive(const sf::VertexArray &coords, sf::RenderTarget &target);
         void DrawBatch();
-        inline bool BatchExists() const { return this->verticesSize != 0; }
-        inline void Reset() { this->currentTexName = ""; }
+        inline bool BatchExists() const { return this->offset != 0; }
+        inline void Reset() { this->currentHandle = -1; this->currentTexture = nullptr; }
+
+        // Static geometry, recorded once per owner and kept on the GPU until invalidated
+        bool DrawStatic(const void *owner, sf::RenderTarget &target);
+        void BeginStatic(const void *owner);
+        void EndStatic(sf::RenderTarget &target);
+        void InvalidateStatic(const void *owner);
+        // Drops every recorded batch, for when textures they point at go away
+        void InvalidateAllStatic();
+        inline bool IsRecordingStatic() const { return this->recordingOwner != nullptr; }
+
+        // World space rect of the camera, anything outside it is skipped before it makes vertices
+        inline void SetCullRect(const sf::FloatRect &rect) { this->cullRect = rect; this->culling = true; }
+        inline void ClearCullRect() { this->culling = false; }
+        inline const sf::FloatRect &GetCullRect() const { return this->cullRect; }
+        // Static batches are recorded whole since they outlive the current view
+        inline bool IsCulling() const { return this->culling && !this->IsRecordingStatic(); }
+        inline bool IsCulled(const sf::FloatRect &bounds) const { return this->IsCulling() && !this->cullRect.intersects(bounds); }
 
     private:
         BatchHandler();
 
+        struct StaticSegment
+        {
+            const sf::Texture *texture;
+            size_t first;
+            size_t count;
+        };
+
+        struct StaticBatch
+        {
+            sf::VertexBuffer buffer;
+            std::vector<sf::Vertex> vertices;
+            std::vector<StaticSegment> segments;
+        };
+
         // Methods
-        void InitializeVertices();
-        void GrowVertices();
+        void PushQuad(const sf::VertexArray &coords, bool textured);
+        void ReserveStream(size_t count);
 
         // Members
-        bool verticesInitialized;
-        std::string currentTexName;
-        int offset;
-        int verticesSize;
-        sf::VertexArray vertices;
+        int currentHandle;
+        const sf::Texture *currentTexture;
+        size_t offset;
+        std::vector<sf::Vertex> vertices;
         sf::RenderTarget *target;
+
+        // Ring buffered stream on the GPU, capacity only ever grows
+        sf::VertexBuffer stream;
+        size_t streamCapacity;
+        size_t streamOffset;
+
+        sf::FloatRect cullRect;
+        bool culling;
+
+        std::unordered_map<const void *, StaticBatch> staticBatches;
+        const void *recordingOwner;
+        StaticBatch *recording;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,51 @@
+#ifndef SBURB_BIT_MASK_H
+#define SBURB_BIT_MASK_H
+
+#include "Common.h"
+
+namespace SBURB
+{
+    // 2D grid of bits packed into 64 bit words, one row after another.
+    class BitMask
+    {
+    public:
+        BitMask();
+        BitMask(int width, int height);
+
+        void Resize(int width, int height);
+        void Fill(bool value);
+        void Release();
+
+        inline bool Get(int x, int y) const
+        {
+            size_t bit = (size_t)y * this->width + x;
+            return (this->bits[bit >> 6] >> (bit & 63)) & 1;
+        }
+
+        inline void Set(int x, int y, bool value)
+        {
+            size_t bit = (size_t)y * this->width + x;
+            if (value)
+                this->bits[bit >> 6] |= (uint64_t)1 << (bit & 63);
+            else
+                this->bits[bit >> 6] &= ~((uint64_t)1 << (bit & 63));
+        }
+
+        // Sets [fromX, toX] on one row, clamped to the mask
+        void SetSpan(int y, int fromX, int toX);
+
+        inline bool Contains(int x, int y) const { return x >= 0 && y >= 0 && x < this->width && y < this->height; }
+        inline bool IsEmpty() const { return this->bits.empty(); }
+
+        int GetWidth() const { return this->width; };
+        int GetHeight() const { return this->height; };
+        size_t GetByteSize() const { return this->bits.size() * sizeof(uint64_t); };
+
+    private:
+        int width;
+        int height;
+        std::vector<uint64_t> bits;
+    };
+}
+
+#endif
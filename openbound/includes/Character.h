@@ -37,12 +37,13 @@ namespace SBURB
 
         bool IsNPC();
 
-        std::string Serialize(std::string output);
+        void Serialize(SerialWriter &out);
 
         int GetOldX() { return this->oldX; };
         int GetOldY() { return this->oldY; };
 
         void SetFacing(std::string facing) { this->facing = facing; };
+        std::string GetFacing() { return this->facing; };
 
         void SetFollowBuffer(std::vector<Vector2> followBuffer) { this->followBuffer = followBuffer; };
 
@@ -3,89 +3,100 @@
 
 #include "Common.h"
 #include <variant>
+#include <functional>
 #include "Action.h"
 #include "ActionQueue.h"
 
 namespace SBURB {
     class CommandHandler {
     public:
+        typedef uint32_t CommandId;
+        typedef std::function<std::shared_ptr<Trigger>(const ActionArgs &args, std::shared_ptr<ActionQueue> queue)> Command;
+
+        // Names resolve to ids once, when an action is parsed. Unknown names get an id too,
+        // so commands can be registered after the actions that use them were loaded.
+        static CommandId GetCommandId(const std::string &name);
+        // Adds a command, or replaces one, builtins included
+        static void RegisterCommand(const std::string &name, Command command);
+        static bool HasCommand(const std::string &name);
+
         static std::shared_ptr<Trigger> PerformActionSilent(std::shared_ptr<Action> action, std::shared_ptr<ActionQueue> queue = nullptr);
 
-        static void Talk(std::string info);
-        static void RandomTalk(std::string info);
-        static void ChangeRoom(std::string info);
-        static void ChangeFocus(std::string info);
-        static void Teleport(std::string info);
-        static void ChangeChar(std::string info);
-        static void PlaySong(std::string info);
-        static void BecomeNPC(std::string info);
-        static void BecomePlayer(std::string info);
-        static void PlaySound(std::string info);
-        static void PlayEffect(std::string info);
-        static void PlayAnimation(std::string info);
-        static void StartAnimation(std::string info);
-        static void AddAction(std::string info);
-        static void AddActions(std::string info);
-        static void RemoveAction(std::string info);
-        static void RemoveActions(std::string info);
-        static void PresentAction(std::string info);
-        static void PresentActions(std::string info);
-        static void OpenChest(std::string info);
-        static void DeltaSprite(std::string info);
-        static void MoveSprite(std::string info);
-        static void DepthSprite(std::string info);
-        static void PlayMovie(std::string info);
-        static void RemoveMovie(std::string info);
-        static void DisableControl(std::string info);
-        static void EnableControl(std::string info);
+        static void Talk(const ActionArgs &args);
+        static void RandomTalk(const ActionArgs &args);
+        static void ChangeRoom(const ActionArgs &args);
+        static void ChangeFocus(const ActionArgs &args);
+        static void Teleport(const ActionArgs &args);
+        static void ChangeChar(const ActionArgs &args);
+        static void PlaySong(const ActionArgs &args);
+        static void BecomeNPC(const ActionArgs &args);
+        static void BecomePlayer(const ActionArgs &args);
+        static void PlaySound(const ActionArgs &args);
+        static void PlayEffect(const ActionArgs &args);
+        static void PlayAnimation(const ActionArgs &args);
+        static void StartAnimation(const ActionArgs &args);
+        static void AddAction(const ActionArgs &args);
+        static void AddActions(const ActionArgs &args);
+        static void RemoveAction(const ActionArgs &args);
+        static void RemoveActions(const ActionArgs &args);
+        static void PresentAction(const ActionArgs &args);
+        static void PresentActions(const ActionArgs &args);
+        static void OpenChest(const ActionArgs &args);
+        static void DeltaSprite(const ActionArgs &args);
+        static void MoveSprite(const ActionArgs &args);
+        static void DepthSprite(const ActionArgs &args);
+        static void PlayMovie(const ActionArgs &args);
+        static void RemoveMovie(const ActionArgs &args);
+        static void DisableControl(const ActionArgs &args);
+        static void EnableControl(const ActionArgs &args);
         /*
         DEPRECATED: DO NOT USE
         */
-        static std::shared_ptr<Trigger> WaitFor(std::string info);
-        static std::shared_ptr<Trigger> Macro(std::string info);
-        static std::shared_ptr<Trigger> Sleep(std::string info);
-        static void PauseActionQueue(std::string info);
-        static void PauseActionQueues(std::string info);
-        static void ResumeActionQueue(std::string info);
-        static void ResumeActionQueues(std::string info);
-        static void CancelActionQueue(std::string info);
-        static void CancelActionQueues(std::string info);
-        static void PauseActionQueueGroup(std::string info);
-        static void PauseActionQueueGroups(std::string info);
-        static void ResumeActionQueueGroup(std::string info);
-        static void ResumeActionQueueGroups(std::string info);
-        static void CancelActionQueueGroup(std::string info);
-        static void CancelActionQueueGroups(std::string info);
-        static void AddSprite(std::string info);
-        static void RemoveSprite(std::string info);
-        static void CloneSprite(std::string info);
-        static void AddWalkable(std::string info);
-        static void AddUnwalkable(std::string info);
-        static void AddMotionPath(std::string info);
-        static void RemoveWalkable(std::string info);
-        static void RemoveUnwalkable(std::string info);
+        static std::shared_ptr<Trigger> WaitFor(const ActionArgs &args);
+        static std::shared_ptr<Trigger> Macro(const ActionArgs &args);
+        static std::shared_ptr<Trigger> Sleep(const ActionArgs &args);
+        static void PauseActionQueue(const ActionArgs &args);
+        static void PauseActionQueues(const ActionArgs &args);
+        static void ResumeActionQueue(const ActionArgs &args);
+        static void ResumeActionQueues(const ActionArgs &args);
+        static void CancelActionQueue(const ActionArgs &args);
+        static void CancelActionQueues(const ActionArgs &args);
+        static void PauseActionQueueGroup(const ActionArgs &args);
+        static void PauseActionQueueGroups(const ActionArgs &args);
+        static void ResumeActionQueueGroup(const ActionArgs &args);
+        static void ResumeActionQueueGroups(const ActionArgs &args);
+        static void CancelActionQueueGroup(const ActionArgs &args);
+        static void CancelActionQueueGroups(const ActionArgs &args);
+        static void AddSprite(const ActionArgs &args);
+        static void RemoveSprite(const ActionArgs &args);
+        static void CloneSprite(const ActionArgs &args);
+        static void AddWalkable(const ActionArgs &args);
+        static void AddUnwalkable(const ActionArgs &args);
+        static void AddMotionPath(const ActionArgs &args);
+        static void RemoveWalkable(const ActionArgs &args);
+        static void RemoveUnwalkable(const ActionArgs &args);
         static void ToggleVolume();
-        static void ChangeMode(std::string info);
-        static void LoadStateFile(std::string info);
+        static void ChangeMode(const ActionArgs &args);
+        static void LoadStateFile(const ActionArgs &args);
         static void FadeOut();
-        static void ChangeRoomRemote(std::string info);
-        static void TeleportRemote(std:: string info);
-        static void SetButtonState(std::string info);
+        static void ChangeRoomRemote(const ActionArgs &args);
+        static void TeleportRemote(const ActionArgs &args);
+        static void SetButtonState(const ActionArgs &args);
         static void SkipDialog();
-        static void Follow(std::string info);
-        static void Unfollow(std::string info);
-        static void AddOverlay(std::string info);
-        static void RemoveOverlay(std::string info);
-        static void Save(std::string info);
-        static void Load(std::string info);
-        static void SaveOrLoad(std::string info);
-        static void SetGameState(std::string info);
-        static void GoBack(std::string info);
-        static void Try(std::string info);
-        static void Walk(std::string info);
-        static void OpenLink(std::string info);
-        static void OpenDirect(std::string info);
-        static void Cancel(std::string info);
+        static void Follow(const ActionArgs &args);
+        static void Unfollow(const ActionArgs &args);
+        static void AddOverlay(const ActionArgs &args);
+        static void RemoveOverlay(const ActionArgs &args);
+        static void Save(const ActionArgs &args);
+        static void Load(const ActionArgs &args);
+        static void SaveOrLoad(const ActionArgs &args);
+        static void SetGameState(const ActionArgs &args);
+        static void GoBack(const ActionArgs &args);
+        static void Try(const ActionArgs &args);
+        static void Walk(const ActionArgs &args);
+        static void OpenLink(const ActionArgs &args);
+        static void OpenDirect(const ActionArgs &args);
+        static void Cancel(const ActionArgs &args);
 
     };
 }
@@ -5,6 +5,7 @@
 #include <string>
 #include <stdint.h>
 #include <cctype>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <SFML/Graphics.hpp>
@@ -41,6 +42,44 @@ namespace SBURB
         Vector4(int x, int y, int z, int w) : x(x), y(y), z(z), w(w){};
     };
 
+    // Points around a sprite's footprint to test against a room's walkable area, with a result slot each.
+    // Coordinates are kept in separate arrays so batch tests can run every point through a polygon edge at once.
+    struct BoundaryQuery
+    {
+        enum Point : int
+        {
+            UpRight,
+            UpLeft,
+            DownLeft,
+            DownRight,
+            DownMid,
+            UpMid,
+            BoxPointCount
+        };
+
+        static constexpr int MAX_POINTS = 8;
+
+        int x[MAX_POINTS];
+        int y[MAX_POINTS];
+        bool results[MAX_POINTS];
+        int count;
+
+        BoundaryQuery() : x(), y(), results(), count(0){};
+
+        void Set(int index, int px, int py) { x[index] = px; y[index] = py; };
+        void Push(int px, int py) { x[count] = px; y[count] = py; count++; };
+
+        bool AllInBounds() const
+        {
+            for (int i = 0; i < count; i++)
+            {
+                if (!results[i])
+                    return false;
+            }
+            return true;
+        };
+    };
+
     // Vector 4 Float
     struct Vector4f
     {
@@ -194,23 +233,52 @@ namespace SBURB
         return "";
     }
 
-    static inline std::vector<pugi::xml_node> GetNestedChildren(pugi::xml_node* node, std::string tagName)
+    static inline void CollectNestedChildren(const pugi::xml_node& node, const char* tagName, std::vector<pugi::xml_node>& nodes)
     {
-        std::vector<pugi::xml_node> nodes = {};
-
-        for (auto child : node->children()) {            
-            if (child.name() == tagName) {
+        for (auto child : node.children()) {
+            if (strcmp(child.name(), tagName) == 0) {
                 nodes.push_back(child);
             }
             else {
-                auto childsChildren = GetNestedChildren(&child, tagName);
-                nodes.insert(nodes.end(), childsChildren.begin(), childsChildren.end());
+                CollectNestedChildren(child, tagName, nodes);
             }
         }
+    }
 
+    // Every descendant with the tag, in document order. Matches aren't searched for more of the same tag.
+    static inline std::vector<pugi::xml_node> GetNestedChildren(pugi::xml_node* node, std::string tagName)
+    {
+        std::vector<pugi::xml_node> nodes = {};
+        CollectNestedChildren(*node, tagName.c_str(), nodes);
         return nodes;
     }
 
+    // GetNestedChildren for several tags in one walk, results[i] gets the matches for tagNames[i].
+    // A match still gets searched for the other tags, just like separate calls would.
+    static inline void GetNestedChildren(const pugi::xml_node& node, const std::vector<const char*>& tagNames, std::vector<std::vector<pugi::xml_node>>& results, uint32_t found = 0)
+    {
+        results.resize(tagNames.size());
+
+        for (auto child : node.children()) {
+            if (child.type() != pugi::node_element) {
+                continue;
+            }
+
+            uint32_t childFound = found;
+            for (size_t i = 0; i < tagNames.size(); i++) {
+                if (!(found & (1u << i)) && strcmp(child.name(), tagNames[i]) == 0) {
+                    results[i].push_back(child);
+                    childFound |= 1u << i;
+                }
+            }
+
+            // Nothing left to look for below once every tag has matched on the way down
+            if (childFound != (1u << tagNames.size()) - 1) {
+                GetNestedChildren(child, tagNames, results, childFound);
+            }
+        }
+    }
+
     static inline pugi::xml_node GetNestedChild(pugi::xml_node* node, std::string tagName)
     {
         for (auto child : node->children()) {
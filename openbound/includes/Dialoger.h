@@ -5,6 +5,7 @@
 #include <SFML/Graphics/Drawable.hpp>
 #include "FontEngine.h"
 #include "Sprite.h"
+#include "SpriteButton.h"
 
 namespace SBURB
 {
@@ -15,6 +16,7 @@ namespace SBURB
         ~Dialoger();
 
         void HandleType();
+        void ResolveSocialButtons();
         void Nudge();
         void SkipAll();
 
@@ -32,7 +34,7 @@ namespace SBURB
         Vector4 DecideDialogDimensions();
 
         void SetBox(std::string box);
-        std::string Serialize(std::string output);
+        void Serialize(SerialWriter &out);
 
         void SetQueue(std::vector<std::string> queue) { this->queue = queue; };
         std::vector<std::string> GetQueue() { return this->queue; };
@@ -63,6 +65,14 @@ namespace SBURB
         std::shared_ptr<Sprite> dialogSpriteRight;
         std::shared_ptr<Sprite> graphic;
 
+        // Social dialog chrome, looked up again only when the binding epoch moves on instead of by name every frame
+        uint32_t buttonsEpoch;
+        std::shared_ptr<SpriteButton> closeButton;
+        std::shared_ptr<SpriteButton> spadeButton;
+        std::shared_ptr<SpriteButton> heartButton;
+        std::shared_ptr<SpriteButton> bubbleButton;
+        std::shared_ptr<SpriteButton> hashTagBar;
+
         Vector2 hiddenPos;
         Vector2 alertPos;
         Vector2 talkPosLeft;
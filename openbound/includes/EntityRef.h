@@ -0,0 +1,44 @@
+#ifndef SBURB_ENTITY_REF_H
+#define SBURB_ENTITY_REF_H
+
+#include "Common.h"
+#include "EntityRegistry.h"
+
+namespace SBURB
+{
+    class Sprite;
+    class Room;
+
+    typedef EntityRegistry<Sprite>::Handle SpriteHandle;
+    typedef EntityRegistry<Room>::Handle RoomHandle;
+
+    // A sprite or room named by a trigger or action. The name is looked up the first time it's needed and
+    // the handle kept, it's only looked up again once sprites or rooms were added or replaced since.
+    // Sprite refs named "char" always follow the player character.
+    template <typename T>
+    class EntityRef
+    {
+    public:
+        EntityRef(const std::string &name = "") : name(name), character(name == "char"), epoch(0) {}
+
+        std::shared_ptr<T> Get();
+
+        const std::string &GetName() const { return this->name; };
+
+    private:
+        std::string name;
+        bool character;
+        typename EntityRegistry<T>::Handle handle;
+        uint32_t epoch;
+    };
+
+    template <>
+    std::shared_ptr<Sprite> EntityRef<Sprite>::Get();
+    template <>
+    std::shared_ptr<Room> EntityRef<Room>::Get();
+
+    typedef EntityRef<Sprite> SpriteRef;
+    typedef EntityRef<Room> RoomRef;
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef SBURB_ENTITY_REGISTRY_H
+#define SBURB_ENTITY_REGISTRY_H
+
+#include "Common.h"
+#include <unordered_map>
+#include <utility>
+
+namespace SBURB
+{
+    // Named objects kept back to back in one vector, with handles that stay valid as long as the entry does.
+    // A handle is a slot plus the generation it was handed out in, once the entry is removed the slot's
+    // generation moves on and old handles simply stop resolving instead of pointing at whatever came next.
+    //
+    // Iterating walks the entries in the order they were added, handing out references, nothing is copied.
+    template <typename T>
+    class EntityRegistry
+    {
+    public:
+        typedef std::pair<std::string, std::shared_ptr<T>> Entry;
+        typedef typename std::vector<Entry>::const_iterator Iterator;
+
+        struct Handle
+        {
+            uint32_t slot = 0;
+            // Zero is never handed out, so a default handle is always empty
+            uint32_t generation = 0;
+
+            explicit operator bool() const { return this->generation != 0; }
+            bool operator==(const Handle &other) const { return this->slot == other.slot && this->generation == other.generation; }
+            bool operator!=(const Handle &other) const { return !(*this == other); }
+        };
+
+        // Adds an entry or replaces the object behind an existing name, which keeps its handle
+        Handle Set(const std::string &name, std::shared_ptr<T> value)
+        {
+            auto found = this->index.find(name);
+            if (found != this->index.end())
+            {
+                Slot &slot = this->slots[found->second];
+                this->entries[slot.entry].second = value;
+                return {found->second, slot.generation};
+            }
+
+            uint32_t slotIndex;
+            if (!this->freeSlots.empty())
+            {
+                slotIndex = this->freeSlots.back();
+                this->freeSlots.pop_back();
+            }
+            else
+            {
+                slotIndex = this->slots.size();
+                this->slots.push_back({0, 0});
+            }
+
+            Slot &slot = this->slots[slotIndex];
+            slot.entry = this->entries.size();
+            slot.generation++;
+
+            this->entries.emplace_back(name, value);
+            this->entrySlots.push_back(slotIndex);
+            this->index[name] = slotIndex;
+
+            return {slotIndex, slot.generation};
+        }
+
+        // An empty handle if nothing goes by that name
+        Handle Find(const std::string &name) const
+        {
+            auto found = this->index.find(name);
+            if (found == this->index.end())
+                return {};
+
+            return {found->second, this->slots[found->second].generation};
+        }
+
+        // Null for unknown names, unlike map's operator[] nothing gets added by asking
+        const std::shared_ptr<T> &Get(const std::string &name) const
+        {
+            auto found = this->index.find(name);
+            if (found == this->index.end())
+                return empty;
+
+            return this->entries[this->slots[found->second].entry].second;
+        }
+
+        // Null once the entry the handle was made for is gone
+        const std::shared_ptr<T> &Get(Handle handle) const
+        {
+            if (!this->IsValid(handle))
+                return empty;
+
+            return this->entries[this->slots[handle.slot].entry].second;
+        }
+
+        bool IsValid(Handle handle) const
+        {
+            return handle && handle.slot < this->slots.size() && this->slots[handle.slot].generation == handle.generation;
+        }
+
+        bool Contains(const std::string &name) const { return this->index.count(name) > 0; }
+
+        bool Remove(const std::string &name)
+        {
+            auto found = this->index.find(name);
+            if (found == this->index.end())
+                return false;
+
+            uint32_t slotIndex = found->second;
+            uint32_t entry = this->slots[slotIndex].entry;
+            uint32_t last = this->entries.size() - 1;
+
+            // Keep entries packed by moving the last one into the hole
+            if (entry != last)
+            {
+                this->entries[entry] = std::move(this->entries[last]);
+                this->entrySlots[entry] = this->entrySlots[last];
+                this->slots[this->entrySlots[entry]].entry = entry;
+            }
+
+            this->entries.pop_back();
+            this->entrySlots.pop_back();
+            this->index.erase(found);
+
+            this->slots[slotIndex].generation++;
+            this->freeSlots.push_back(slotIndex);
+            return true;
+        }
+
+        void Clear()
+        {
+            // Slots stay around so handles from before can never match anything added later
+            for (uint32_t slotIndex : this->entrySlots)
+            {
+                this->slots[slotIndex].generation++;
+                this->freeSlots.push_back(slotIndex);
+            }
+
+            this->entries.clear();
+            this->entrySlots.clear();
+            this->index.clear();
+        }
+
+        size_t Size() const { return this->entries.size(); }
+        bool Empty() const { return this->entries.empty(); }
+
+        Iterator begin() const { return this->entries.begin(); }
+        Iterator end() const { return this->entries.end(); }
+
+    private:
+        struct Slot
+        {
+            uint32_t entry;
+            uint32_t generation;
+        };
+
+        std::vector<Entry> entries;
+        // Which slot each entry belongs to, so moving an entry can fix its slot up
+        std::vector<uint32_t> entrySlots;
+        std::vector<Slot> slots;
+        std::vector<uint32_t> freeSlots;
+        std::unordered_map<std::string, uint32_t> index;
+
+        inline static const std::shared_ptr<T> empty = nullptr;
+    };
+}
+
+#endif
@@ -3,18 +3,55 @@
 
 #include <pugixml.hpp>
 #include "Common.h"
+#include "Signals.h"
 
 namespace SBURB
 {
+    // "prop op target" from a trigger, split up once when the trigger is parsed
+    class EventCondition
+    {
+    public:
+        enum Operator
+        {
+            Greater,
+            Less,
+            NotEqual,
+            Equal,
+            Invalid
+        };
+
+        EventCondition(const std::string &query);
+
+        // Greater and Less are false unless both sides are numbers
+        bool Test(const std::string &value, int number, bool numeric) const;
+        bool Test(const std::string &value) const;
+
+        Operator GetOperator() const { return this->op; };
+        const std::string &GetProp() const { return this->prop; };
+        bool IsNumeric() const { return this->op == Greater || this->op == Less; };
+
+    private:
+        Operator op;
+        std::string prop;
+        std::string target;
+        int targetNumber;
+        bool targetNumeric;
+    };
+
     class Event
     {
     public:
         Event();
-        ~Event();
+        virtual ~Event();
 
         virtual void Reset() = 0;
         virtual std::string Serialize();
         virtual bool CheckCompletion() = 0;
+        // What the result depends on, anything not listed can't change it. Unknown events are polled.
+        virtual uint32_t GetSignals() { return SignalAlways; };
+        // The room the event belongs to was left or entered again, nothing checks it in between
+        virtual void Pause() {};
+        virtual void Resume() {};
 
         bool canSerialize;
         
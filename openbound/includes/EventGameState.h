@@ -3,6 +3,7 @@
 
 #include "Common.h"
 #include "Event.h"
+#include "GameState.h"
 
 namespace SBURB
 {
@@ -14,13 +15,11 @@ namespace SBURB
 
         virtual void Reset() override;
         virtual bool CheckCompletion() override;
-
-        bool canSerialize;
+        virtual uint32_t GetSignals() override { return SignalGameState; };
 
     protected:
-        std::string token;
-        std::string prop;
-        std::string target;
+        EventCondition condition;
+        GameState::Handle handle;
 
     };
 }
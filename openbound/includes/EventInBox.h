@@ -4,6 +4,7 @@
 #include <pugixml.hpp>
 #include "Common.h"
 #include "Event.h"
+#include "EntityRef.h"
 
 namespace SBURB
 {
@@ -15,12 +16,10 @@ namespace SBURB
 
         virtual void Reset() override;
         virtual bool CheckCompletion() override;
-
-        bool canSerialize;
+        virtual uint32_t GetSignals() override { return SignalSprites; };
 
     protected:
-        std::shared_ptr<Sprite> entity;
-        std::string spriteName;
+        SpriteRef entity;
         int x;
         int y;
         int width;
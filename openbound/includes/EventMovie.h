@@ -15,8 +15,7 @@ namespace SBURB
 
         virtual void Reset() override;
         virtual bool CheckCompletion() override;
-
-        bool canSerialize;
+        virtual uint32_t GetSignals() override { return SignalNone; };
 
     protected:
         std::string movieName;
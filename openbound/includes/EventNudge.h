@@ -15,12 +15,10 @@ namespace SBURB
 
         virtual void Reset() override;
         virtual bool CheckCompletion() override;
-
-        bool canSerialize;
+        virtual uint32_t GetSignals() override { return SignalInput; };
 
     protected:
 
-
     };
 }
 #endif
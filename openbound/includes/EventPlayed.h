@@ -4,6 +4,7 @@
 #include <pugixml.hpp>
 #include "Common.h"
 #include "Event.h"
+#include "EntityRef.h"
 #include "Sprite.h"
 
 namespace SBURB
@@ -17,11 +18,8 @@ namespace SBURB
         virtual void Reset() override;
         virtual bool CheckCompletion() override;
 
-        bool canSerialize;
-
     protected:
-        std::shared_ptr<Sprite> entity;
-        std::string spriteName;
+        SpriteRef entity;
 
     };
 }
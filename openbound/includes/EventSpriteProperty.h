@@ -4,6 +4,7 @@
 #include <pugixml.hpp>
 #include "Common.h"
 #include "Event.h"
+#include "EntityRef.h"
 #include "Sprite.h"
 
 namespace SBURB
@@ -16,17 +17,20 @@ namespace SBURB
 
         virtual void Reset() override;
         virtual bool CheckCompletion() override;
-
-        bool canSerialize;
+        virtual uint32_t GetSignals() override { return SignalSprites; };
 
     protected:
-        std::shared_ptr<Sprite> entity;
-        std::string spriteName;
-        std::string query;
+        // Positions are compared as numbers straight off the sprite, everything else through GetProp
+        enum class Property {
+            X,
+            Y,
+            Other
+        };
+
+        SpriteRef entity;
 
-        std::string token;
-        std::string prop;
-        std::string target;
+        EventCondition condition;
+        Property property;
 
     };
 }
@@ -16,12 +16,18 @@ namespace SBURB
         virtual void Reset() override;
         virtual std::string Serialize() override;
         virtual bool CheckCompletion() override;
-
-        bool canSerialize;
+        virtual uint32_t GetSignals() override { return SignalTimer; };
+        virtual void Pause() override;
+        virtual void Resume() override;
 
     protected:
-        int time;
         int originalTime;
+        uint32_t deadline;
+        // Set by the first check after a reset
+        bool armed;
+        // Ticks that were left when the room was exited, the deadline is set again on the way back in
+        uint32_t remaining;
+        bool paused;
 
     };
 }
@@ -4,6 +4,7 @@
 #include <pugixml.hpp>
 #include "Common.h"
 #include "Event.h"
+#include "EntityRef.h"
 
 namespace SBURB
 {
@@ -15,12 +16,11 @@ namespace SBURB
 
         virtual void Reset() override;
         virtual bool CheckCompletion() override;
-
-        bool canSerialize;
+        virtual uint32_t GetSignals() override { return SignalSprites; };
 
     protected:
-        std::string spriteName1;
-        std::string spriteName2;
+        SpriteRef sprite1;
+        SpriteRef sprite2;
         float distance;
 
     };
@@ -33,11 +33,11 @@ namespace SBURB
         
         bool Collides(std::shared_ptr<Sprite> sprite, int dx = 0, int dy = 0);
         
-        std::map<std::string, Vector2> GetBoundaryQueries(int dx = 0, int dy = 0);
+        void GetBoundaryQueries(BoundaryQuery &query, int dx = 0, int dy = 0);
         
         bool TryToMove();
 
-        std::string Serialize(std::string output);
+        void Serialize(SerialWriter &out);
 
         void SetFacing(std::string facing) { this->facing = facing; };
 
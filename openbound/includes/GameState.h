@@ -0,0 +1,57 @@
+#ifndef SBURB_GAME_STATE_H
+#define SBURB_GAME_STATE_H
+
+#include "Common.h"
+#include <map>
+#include <unordered_map>
+
+namespace SBURB
+{
+    // Key/value store behind gameState. Keys are interned to handles so triggers can resolve them
+    // once at parse time, and numeric values are parsed when written instead of every time they are read.
+    class GameState
+    {
+    public:
+        typedef int Handle;
+
+        // Handles stay valid for the life of the store, Clear only forgets the values
+        Handle GetHandle(const std::string &key);
+
+        void Set(const std::string &key, const std::string &value) { this->Set(this->GetHandle(key), value); };
+        void Set(Handle handle, const std::string &value);
+
+        const std::string &Get(Handle handle) const { return this->entries[handle].value; };
+        const std::string &Get(const std::string &key) const;
+
+        // False if the value doesn't start with a number, like std::stoi would have thrown
+        inline bool GetNumber(Handle handle, int &number) const
+        {
+            const Entry &entry = this->entries[handle];
+            number = entry.number;
+            return entry.numeric;
+        }
+
+        void Clear();
+
+        // Keys that have been given a value, in key order
+        std::map<std::string, std::string> ToMap() const;
+
+        // Parses a leading integer the way std::stoi does, without the exceptions
+        static bool ParseNumber(const std::string &value, int &number);
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            std::string value;
+            int number = 0;
+            bool numeric = false;
+            bool set = false;
+        };
+
+        std::vector<Entry> entries;
+        std::unordered_map<std::string, Handle> handles;
+    };
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef SBURB_PROFILER_H
+#define SBURB_PROFILER_H
+
+#include "Common.h"
+#include <SFML/System/Clock.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <vector>
+
+namespace SBURB
+{
+    // Collects scoped timings and a few per frame counters. Everything is a no-op until enabled.
+    class Profiler
+    {
+    public:
+        enum Counter
+        {
+            DrawCalls,
+            Vertices,
+            TriggerEvaluations,
+            CounterCount
+        };
+
+        // Singleton Initialization
+        inline static Profiler &getInstance()
+        {
+            static Profiler instance;
+            return instance;
+        }
+
+        // Delete methods we don't want
+        Profiler(Profiler const &) = delete;
+        void operator=(Profiler const &) = delete;
+
+        inline static bool IsEnabled() { return enabled; }
+        void SetEnabled(bool enabled);
+
+        bool GetShowOverlay() { return this->showOverlay; };
+        void SetShowOverlay(bool showOverlay) { this->showOverlay = showOverlay; };
+
+        inline sf::Int64 Now() const { return this->clock.getElapsedTime().asMicroseconds(); }
+
+        void BeginFrame();
+        void EndFrame();
+        void AddSample(const char *name, sf::Int64 start, sf::Int64 end, int depth);
+        inline void Count(Counter counter, int amount = 1) { this->frameCounters[counter] += amount; }
+
+        inline int PushScope() { return this->depth++; }
+        inline void PopScope() { this->depth--; }
+
+        void DrawOverlay(sf::RenderTarget &target);
+        bool ExportTrace(std::string path);
+
+    private:
+        Profiler();
+
+        struct Sample
+        {
+            const char *name;
+            sf::Int64 start;
+            sf::Int64 duration;
+            int depth;
+        };
+
+        struct CounterSample
+        {
+            sf::Int64 time;
+            int values[CounterCount];
+        };
+
+        struct Phase
+        {
+            const char *name;
+            int depth;
+            sf::Int64 frameTime;
+            float average;
+        };
+
+        inline static bool enabled = false;
+
+        bool showOverlay;
+        sf::Clock clock;
+        int depth;
+
+        sf::Int64 frameStart;
+        float averageFrameTime;
+
+        int frameCounters[CounterCount];
+        int lastCounters[CounterCount];
+
+        std::vector<Phase> phases;
+
+        // Ring buffers for the trace export
+        std::vector<Sample> samples;
+        size_t nextSample;
+        std::vector<CounterSample> counterSamples;
+        size_t nextCounterSample;
+    };
+
+    class ProfileScope
+    {
+    public:
+        inline ProfileScope(const char *name) : name(name), active(Profiler::IsEnabled())
+        {
+            if (this->active)
+            {
+                this->depth = Profiler::getInstance().PushScope();
+                this->start = Profiler::getInstance().Now();
+            }
+        }
+
+        inline ~ProfileScope()
+        {
+            if (this->active)
+            {
+                Profiler &profiler = Profiler::getInstance();
+                profiler.AddSample(this->name, this->start, profiler.Now(), this->depth);
+                profiler.PopScope();
+            }
+        }
+
+    private:
+        const char *name;
+        bool active;
+        int depth;
+        sf::Int64 start;
+    };
+}
+
+// Define SBURB_NO_PROFILER to compile the instrumentation out entirely.
+#ifdef SBURB_NO_PROFILER
+#define SBURB_PROFILE_SCOPE(name)
+#define SBURB_PROFILE_COUNT(counter, amount)
+#else
+#define SBURB_PROFILE_CONCAT_INNER(a, b) a##b
+#define SBURB_PROFILE_CONCAT(a, b) SBURB_PROFILE_CONCAT_INNER(a, b)
+#define SBURB_PROFILE_SCOPE(name) SBURB::ProfileScope SBURB_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define SBURB_PROFILE_COUNT(counter, amount)                                       \
+    do                                                                             \
+    {                                                                              \
+        if (SBURB::Profiler::IsEnabled())                                          \
+            SBURB::Profiler::getInstance().Count(SBURB::Profiler::counter, amount); \
+    } while (0)
+#endif
+
+#endif
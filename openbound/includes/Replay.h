@@ -0,0 +1,51 @@
+#ifndef SBURB_REPLAY_H
+#define SBURB_REPLAY_H
+
+#include "Common.h"
+
+#include <SFML/Window/Event.hpp>
+
+#include <fstream>
+#include <deque>
+
+namespace SBURB
+{
+    // Records input events against simulation ticks so a session can be played back deterministically,
+    // and optionally writes a hash of the game state after every tick.
+    class Replay
+    {
+    public:
+        Replay();
+        ~Replay();
+
+        bool StartRecording(std::string path);
+        bool LoadRecording(std::string path);
+        bool OpenHashLog(std::string path);
+        void Close(uint32_t tick);
+
+        void RecordEvent(uint32_t tick, const sf::Event &event);
+        bool PollEvent(uint32_t tick, sf::Event &event);
+        void WriteStateHash(uint32_t tick, uint64_t hash);
+
+        bool IsRecording() { return this->recordFile.is_open(); };
+        bool IsPlaying() { return this->playing; };
+        bool IsHashing() { return this->hashFile.is_open(); };
+        bool IsFinished(uint32_t tick) { return this->playing && this->events.empty() && tick >= this->length; };
+        uint32_t GetLength() { return this->length; };
+
+    private:
+        struct ReplayEvent
+        {
+            uint32_t tick;
+            sf::Event event;
+        };
+
+        std::ofstream recordFile;
+        std::ofstream hashFile;
+        std::deque<ReplayEvent> events;
+        bool playing;
+        uint32_t length;
+    };
+}
+
+#endif
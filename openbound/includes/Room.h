@@ -6,6 +6,8 @@
 #include "AssetPath.h"
 #include "Trigger.h"
 #include "Sprite.h"
+#include "SpatialGrid.h"
+#include "BitMask.h"
 
 namespace SBURB
 {
@@ -44,34 +46,49 @@ namespace SBURB
 		void Enter();
 		void Exit();
 
+		// Graphics the room draws with, for keeping them resident while we're here
+		void CollectAssets(std::vector<std::shared_ptr<Asset>>& assets);
+		// Rooms reachable through changeRoom and teleport actions in this room
+		void CollectNeighbours(std::vector<std::string>& rooms);
+
 		bool Contains(std::shared_ptr<Sprite> sprite);
+		const std::vector<std::shared_ptr<Sprite>>& GetSprites() { return this->sprites; };
 
 		void Update();
 
 		void SortDepths();
+		void UpdateStaticLayer();
 
 		std::vector<std::shared_ptr<Action>> QueryActions(std::shared_ptr<Sprite> query, int x, int y);
 		std::vector<std::shared_ptr<Action>> QueryActionsVisual(std::shared_ptr<Sprite> query, int x, int y);
 
 		bool IsInBounds(Sprite* sprite, int dx = 0, int dy = 0);
-		std::map<std::string, bool> IsInBoundsBatch(std::map<std::string, Vector2> queries, std::map<std::string, bool>* results);
+		void IsInBoundsBatch(BoundaryQuery& query);
 
 		std::shared_ptr<Sprite> Collides(Sprite* sprite, int dx = 0, int dy = 0);
 
-		std::string Serialize(std::string output);
+		// Whether a point is inside any walkable and any unwalkable path, false if the mask can't tell
+		bool LookupWalkMask(int x, int y, bool& walk, bool& block);
+		void BakeWalkMask();
+
+		void Serialize(SerialWriter &out);
 
 		std::string GetName() { return this->name; };
 
 		void SetMapScale(int mapScale) { this->mapScale = mapScale; };
 		int GetMapScale() { return this->mapScale; };
 
-		void SetWalkableMap(std::shared_ptr<AssetGraphic> walkableMap) { this->walkableMap = walkableMap; };
+		// Size in pixels of a baked path mask cell, 0 to always test the polygons
+		void SetWalkMaskScale(int walkMaskScale) { this->walkMaskScale = walkMaskScale; this->walkMaskDirty = true; };
+		int GetWalkMaskScale() { return this->walkMaskScale; };
+
+		void SetWalkableMap(std::shared_ptr<AssetGraphic> walkableMap) { this->walkableMap = walkableMap; this->mapData = walkableMap ? walkableMap->GetWalkMask() : nullptr; };
 		std::shared_ptr<AssetGraphic> GetWalkableMap() { return this->walkableMap; };
 
-		void SetWidth(int width) { this->width = width; };
+		void SetWidth(int width) { this->width = width; this->grid.Resize(this->width, this->height); this->walkMaskDirty = true; };
 		int GetWidth() { return this->width; };
 
-		void SetHeight(int height) { this->height = height; };
+		void SetHeight(int height) { this->height = height; this->grid.Resize(this->width, this->height); this->walkMaskDirty = true; };
 		int GetHeight() { return this->height; };
 
     private:
@@ -85,9 +102,29 @@ namespace SBURB
 		std::vector<std::shared_ptr<MotionPath>> motionPaths;
 		std::vector<std::shared_ptr<Trigger>> triggers;
 		std::shared_ptr<AssetGraphic> walkableMap;
-		std::shared_ptr<sf::Image> mapData;
+		std::shared_ptr<const BitMask> mapData;
 		int mapScale;
 
+		// Paths baked to bits, cells an outline passes through are flagged as edges and tested exactly
+		int walkMaskScale;
+		bool walkMaskDirty;
+		BitMask pathWalk;
+		BitMask pathBlock;
+		BitMask pathEdge;
+
+		// Sprites bucketed by position, plus scratch space for queries against it
+		SpatialGrid grid;
+		std::vector<std::shared_ptr<Sprite>> nearby;
+
+		// Leading run of sorted sprites drawn from a cached buffer, and a hash to know when to rebuild it
+		size_t staticCount;
+		size_t staticSignature;
+
+		// What the triggers listen to, and when they were last looked at
+		uint32_t triggerSignals;
+		uint64_t triggersCheckedAt;
+		bool triggersDirty;
+
 	private:
 		virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
 
@@ -0,0 +1,49 @@
+#ifndef SBURB_SAVE_STORE_H
+#define SBURB_SAVE_STORE_H
+
+#include "Common.h"
+#include "SerialWriter.h"
+
+#include <functional>
+
+namespace SBURB
+{
+    // Save slots, a manual and an automatic one per game. Local saves are files in the save directory,
+    // the others only last until the game closes, like local and session storage did in the browser.
+    // Autosaves only copy what changes in play, a background writer patches that into the last full
+    // serialization, then compresses and stores it.
+    //
+    // Layout:
+    //   header  magic "SBSV", u32 version, i64 timestamp in seconds, u32 description length, description
+    //   body    the serialized state as a zlib stream, running to the end of the file
+    class SaveStore
+    {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        struct Header
+        {
+            std::string description;
+            int64_t timestamp = 0;
+        };
+
+        static bool Save(const std::string &description, bool automatic, bool local);
+        // Loads and anything that adds to or rearranges the state call this, the next autosave serializes everything
+        static void InvalidateBase();
+        // Blocks until every autosave taken so far has been written
+        static void FinishWriting();
+        // Replaces the current state with the slot's, assets that are still resident are kept
+        static bool Load(bool automatic, bool local);
+        static bool Exists(bool automatic, bool local);
+        // Only reads as far as the header, the body isn't touched
+        static bool ReadHeader(bool automatic, bool local, Header &header);
+
+        // A whole save, the body callback streams the state through the compressor
+        static bool Write(SerialWriter &out, const Header &header, const std::function<void(SerialWriter &)> &body);
+
+        static void SetDirectory(const std::string &directory);
+        static std::string GetSlotPath(bool automatic);
+    };
+}
+
+#endif
@@ -12,8 +12,14 @@
 #include "Sound.h"
 #include "ActionQueue.h"
 #include "Dialoger.h"
+#include "Replay.h"
+#include "GameState.h"
+#include "Signals.h"
+#include "EntityRegistry.h"
+#include "EntityRef.h"
 
 #include <pugixml.hpp>
+#include <set>
 
 namespace SBURB
 {
@@ -26,7 +32,9 @@ namespace SBURB
         static Sburb *GetInstance();
 
         void Update();
+        void Tick();
         void Render();
+        void DrawLoadingScreen();
 
         void PurgeState();
 
@@ -35,6 +43,8 @@ namespace SBURB
         void HandleHud();
         void FocusCamera();
         void HandleRoomChange();
+        // Pins the current room and its neighbours, then lets everything else fall out of memory
+        void UpdateResidency();
         void ChainAction();
         void UpdateWait();
         void BeginChoosing();
@@ -42,39 +52,59 @@ namespace SBURB
         void ChainActionInQueue(std::shared_ptr<ActionQueue> queue);
 
         bool Start();
+        bool StartHeadless(uint32_t maxTicks = 0);
+
+        void SetHeadless(bool headless) { this->headless = headless; };
+        bool IsHeadless() { return this->headless; };
+
+        Replay& GetReplay() { return this->replay; };
+        uint32_t GetTickCount() { return this->tickCount; };
+        uint64_t HashState();
 
         double GetFPS();
+
+        void SetTickRate(sf::Int32 ticksPerSecond);
+        void SetRenderRate(sf::Int32 framesPerSecond);
+        void SetInterpolation(bool interpolate) { this->interpolate = interpolate; };
         std::string GetName();
 
         void SetCurrentRoom(std::shared_ptr<Room> curRoom) { this->curRoom = curRoom; };
         std::shared_ptr<Room> GetCurrentRoom();
 
-        void SetSprite(std::string name, std::shared_ptr<Sprite> sprite) { this->sprites[name] = sprite; };
-        std::shared_ptr<Sprite> GetSprite(std::string name) { return this->sprites[name]; };
+        void SetSprite(const std::string &name, std::shared_ptr<Sprite> sprite) { this->sprites.Set(name, sprite); this->bindingEpoch++; };
+        std::shared_ptr<Sprite> GetSprite(const std::string &name) { return this->sprites.Get(name); };
+        std::shared_ptr<Sprite> GetSprite(SpriteHandle handle) { return this->sprites.Get(handle); };
+        SpriteHandle GetSpriteHandle(const std::string &name) { return this->sprites.Find(name); };
 
-        std::map<std::string, std::shared_ptr<Room>> GetRooms() { return this->rooms; };
+        const EntityRegistry<Room> &GetRooms() { return this->rooms; };
 
-        void SetRoom(std::string name, std::shared_ptr<Room> room) { this->rooms[name] = room; };
-        std::shared_ptr<Room> GetRoom(std::string name) { return this->rooms[name]; };
+        void SetRoom(const std::string &name, std::shared_ptr<Room> room) { this->rooms.Set(name, room); this->bindingEpoch++; };
+        std::shared_ptr<Room> GetRoom(const std::string &name) { return this->rooms.Get(name); };
+        std::shared_ptr<Room> GetRoom(RoomHandle handle) { return this->rooms.Get(handle); };
+        RoomHandle GetRoomHandle(const std::string &name) { return this->rooms.Find(name); };
 
-        void SetButton(std::string name, std::shared_ptr<SpriteButton> button) { this->buttons[name] = button; }
-        std::shared_ptr<SpriteButton> GetButton(std::string name) { return this->buttons[name]; };
+        // Moves on whenever sprites, rooms or buttons are added, replaced or cleared, so refs know to look their names up again
+        uint32_t GetBindingEpoch() { return this->bindingEpoch; };
 
-        void SetEffect(std::string, std::shared_ptr<Animation> anim) { this->effects[name] = anim; };
-        std::shared_ptr<Animation> GetEffect(std::string name) { return this->effects[name]; };
+        void SetButton(const std::string &name, std::shared_ptr<SpriteButton> button) { this->buttons.Set(name, button); this->bindingEpoch++; }
+        std::shared_ptr<SpriteButton> GetButton(const std::string &name) { return this->buttons.Get(name); };
 
-        void SetGameState(std::string prop, std::string value) { this->gameState[prop] = value; };
-        std::map<std::string, std::string> GetGameState() { return this->gameState; };
-        std::string GetGameState(std::string prop) { return this->gameState[prop]; };
+        void SetEffect(const std::string &name, std::shared_ptr<Animation> anim) { this->effects.Set(name, anim); };
+        std::shared_ptr<Animation> GetEffect(const std::string &name) { return this->effects.Get(name); };
 
-        std::map<std::string, std::shared_ptr<Sprite>> GetHud() { return this->hud; };
-        std::shared_ptr<Sprite> GetHud(std::string name) { return this->hud[name]; };
+        void SetGameState(std::string prop, std::string value) { this->gameState.Set(prop, value); };
+        std::map<std::string, std::string> GetGameState() { return this->gameState.ToMap(); };
+        std::string GetGameState(std::string prop) { return this->gameState.Get(prop); };
+        GameState &GetGameStateTable() { return this->gameState; };
 
-        std::map<std::string, std::shared_ptr<Sprite>> GetSprites() { return this->sprites; };
-        std::map<std::string, std::shared_ptr<Animation>> GetEffects() { return this->effects; };
-        std::map<std::string, std::shared_ptr<SpriteButton>> GetButtons() { return this->buttons; };
+        const EntityRegistry<Sprite> &GetHud() { return this->hud; };
+        std::shared_ptr<Sprite> GetHud(const std::string &name) { return this->hud.Get(name); };
 
-        std::vector<std::shared_ptr<ActionQueue>> GetActionQueues() { return this->actionQueues; };
+        const EntityRegistry<Sprite> &GetSprites() { return this->sprites; };
+        const EntityRegistry<Animation> &GetEffects() { return this->effects; };
+        const EntityRegistry<SpriteButton> &GetButtons() { return this->buttons; };
+
+        const std::vector<std::shared_ptr<ActionQueue>> &GetActionQueues() { return this->actionQueues; };
         std::shared_ptr<ActionQueue> GetActionQueueById(std::string id);
         void RemoveActionQueueById(std::string id);
         void RemoveActionQueuesByGroup(std::string group);
@@ -105,7 +135,7 @@ namespace SBURB
         void SetLoadingRoom(bool loadingRoom) { this->loadingRoom = loadingRoom; };
         bool GetLoadingRoom() { return this->loadingRoom; };
 
-        void SetCharacter(std::shared_ptr<Character> character) { this->character = character; };
+        void SetCharacter(std::shared_ptr<Character> character) { this->character = character; Signals::Publish(SignalSprites); };
         std::shared_ptr<Character> GetCharacter() { return this->character; };
 
         std::shared_ptr<Chooser> GetChooser() { return this->chooser; };
@@ -128,12 +158,12 @@ namespace SBURB
         void SaveStateToStorage(std::string state, bool automatic, bool local);
         void LoadStateFromStorage(bool automatic, bool local);
         bool IsStateInStorage(bool automatic, bool local);
-        std::string GetStateDescription(bool automatic);
+        std::string GetStateDescription(bool automatic, bool local);
 
         void SetNextQueueId(int nextQueueId) { this->nextQueueId = nextQueueId; };
         int GetNextQueueId() { return this->nextQueueId;};
 
-        void SetHud(std::string name, std::shared_ptr<Sprite> sprite) { this->hud[name] = sprite; };
+        void SetHud(const std::string &name, std::shared_ptr<Sprite> sprite) { this->hud.Set(name, sprite); };
 
         void HaltUpdateProcess();
         void StartUpdateProcess();
@@ -168,6 +198,8 @@ namespace SBURB
         std::string levelPath;
         std::string version;
         std::string resourcePath;
+        // Level files already parsed, keepOld loads skip these
+        std::set<std::string> loadedFiles;
 
     private:
         std::string description;
@@ -206,22 +238,37 @@ namespace SBURB
 
         std::shared_ptr<Trigger> inputDisabledTrigger;
 
-        std::map<std::string, std::string> gameState;
-        std::map<std::string, std::shared_ptr<Room>> rooms;
-        std::map<std::string, std::shared_ptr<Sprite>> sprites;
-        std::map<std::string, std::shared_ptr<SpriteButton>> buttons;
+        GameState gameState;
+        uint32_t bindingEpoch;
+        EntityRegistry<Room> rooms;
+        EntityRegistry<Sprite> sprites;
+        EntityRegistry<SpriteButton> buttons;
         std::map<std::string, std::shared_ptr<sf::Font>> fonts;
-        std::map<std::string, std::shared_ptr<Animation>> effects;
-        std::map<std::string, std::shared_ptr<Sprite>> hud;
+        EntityRegistry<Animation> effects;
+        EntityRegistry<Sprite> hud;
         std::vector<std::shared_ptr<ActionQueue>> actionQueues;
 
         InputHandler inputHandler;
 
         sf::Image icon;
 
+        // FPS is the fixed simulation rate, renderFPS is how often we present.
         sf::Int32 FPS;
+        sf::Int32 renderFPS;
+        sf::Time tickTime;
+        sf::Time renderTime;
+        sf::Time tickAccumulator;
+        sf::Time renderAccumulator;
         sf::Clock FPStimeObj;
 
+        bool interpolate;
+        Vector2 lastViewPos;
+
+        // Headless runs have no window, and get their input from the replay instead.
+        bool headless;
+        uint32_t tickCount;
+        Replay replay;
+
         int destX;
         int destY;
 
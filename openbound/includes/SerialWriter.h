@@ -0,0 +1,111 @@
+#ifndef SBURB_SERIAL_WRITER_H
+#define SBURB_SERIAL_WRITER_H
+
+#include "Common.h"
+#include <fstream>
+
+struct z_stream_s;
+
+namespace SBURB
+{
+    // Where Serialize methods append their output. Text is gathered in a small buffer and handed to the
+    // sink in chunks, so a whole save never has to be copied around while it is being written.
+    class SerialWriter
+    {
+    public:
+        SerialWriter();
+        virtual ~SerialWriter();
+
+        void Write(const char *data, size_t size);
+
+        SerialWriter &operator<<(const std::string &text)
+        {
+            this->Write(text.data(), text.size());
+            return *this;
+        }
+        SerialWriter &operator<<(const char *text)
+        {
+            this->Write(text, strlen(text));
+            return *this;
+        }
+        SerialWriter &operator<<(char character)
+        {
+            this->Write(&character, 1);
+            return *this;
+        }
+        SerialWriter &operator<<(int number);
+        SerialWriter &operator<<(unsigned int number);
+
+        // Passes everything buffered on to the sink. Sinks call this from their destructors,
+        // the base class can't since the sink is already gone by then.
+        void Flush();
+
+        // Bytes written so far, whether or not they reached the sink yet
+        size_t GetWritten() { return this->written; };
+
+    protected:
+        virtual void Drain(const char *data, size_t size) = 0;
+
+    private:
+        std::string buffer;
+        size_t written;
+    };
+
+    // Collects everything into a string
+    class StringSerialWriter : public SerialWriter
+    {
+    public:
+        ~StringSerialWriter();
+
+        // Flushes first
+        std::string &GetString();
+
+    protected:
+        virtual void Drain(const char *data, size_t size) override;
+
+    private:
+        std::string output;
+    };
+
+    // Streams straight to a file
+    class FileSerialWriter : public SerialWriter
+    {
+    public:
+        FileSerialWriter(const std::string &path);
+        ~FileSerialWriter();
+
+        bool IsOpen() { return this->file.is_open(); };
+        // Flushes, then true if nothing failed along the way
+        bool Close();
+
+    protected:
+        virtual void Drain(const char *data, size_t size) override;
+
+    private:
+        std::ofstream file;
+    };
+
+    // Compresses everything written to it as a zlib stream into another writer
+    class DeflateSerialWriter : public SerialWriter
+    {
+    public:
+        DeflateSerialWriter(SerialWriter &sink, int level = -1);
+        ~DeflateSerialWriter();
+
+        // Ends the stream, nothing may be written after. True if zlib had no complaints along the way.
+        bool Finish();
+
+    protected:
+        virtual void Drain(const char *data, size_t size) override;
+
+    private:
+        void Deflate(const char *data, size_t size, int flush);
+
+        SerialWriter &sink;
+        std::unique_ptr<z_stream_s> stream;
+        bool failed;
+        bool finished;
+    };
+}
+
+#endif
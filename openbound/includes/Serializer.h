@@ -5,74 +5,92 @@
 #include "Common.h"
 #include "Sprite.h"
 #include "Asset.h"
+#include "SerialWriter.h"
 
 namespace SBURB {
+    // Hands pugi's output straight to a SerialWriter
+    struct SerialXMLWriter : pugi::xml_writer
+    {
+        SerialWriter &out;
+
+        SerialXMLWriter(SerialWriter &out) : out(out) {}
+
+        virtual void write(const void *data, size_t size) override
+        {
+            this->out.Write((const char *)data, size);
+        }
+    };
+
     class Serializer {
     public:
+        // Streams the whole state out, every object appends to the writer as it goes
+        static void Serialize(SerialWriter &out);
         static std::string Serialize();
-        static std::string SerializeAssets(std::string output);
-        static std::string SerializeTemplates(std::string output);
-        static std::string SerializeHud(std::string output);
-        static std::string SerializeLooseObjects(std::string output);
-        static std::string SerializeRooms(std::string output);
-        static std::string SerializeGameState(std::string output);
-        static std::string SerializeActionQueues(std::string output);
+        // Only the opening sburb element, with the player, music and the files loaded so far
+        static void SerializeRoot(SerialWriter &out);
+        static void SerializeAssets(SerialWriter &out);
+        static void SerializeTemplates(SerialWriter &out);
+        static void SerializeHud(SerialWriter &out);
+        static void SerializeLooseObjects(SerialWriter &out);
+        static void SerializeRooms(SerialWriter &out);
+        static void SerializeGameState(SerialWriter &out);
+        static void SerializeActionQueues(SerialWriter &out);
 
         // SerializeAttribute used to be done with templates, but it was such a hassle, I got annoyed and stopped.
-        static std::string SerializeAttribute(std::string name, bool value, bool defaultValue = false) {
-            return value != defaultValue ? " " + name + "='" + std::to_string(value) + "' " : "";
+        static void SerializeAttribute(SerialWriter &out, const char *name, bool value, bool defaultValue = false) {
+            if (value != defaultValue)
+                out << " " << name << "='" << (int)value << "' ";
         }
 
-        static std::string SerializeAttribute(std::string name, int value, int defaultValue = 0) {
-            return value != defaultValue ? " " + name + "='" + std::to_string(value) + "' " : "";
+        static void SerializeAttribute(SerialWriter &out, const char *name, int value, int defaultValue = 0) {
+            if (value != defaultValue)
+                out << " " << name << "='" << value << "' ";
         }
 
-        static std::string SerializeAttribute(std::string name, std::string value, std::string defaultValue = "") {
-            return value != defaultValue ? " " + name + "='" + value + "' " : "";
+        static void SerializeAttribute(SerialWriter &out, const char *name, const std::string &value, const std::string &defaultValue = "") {
+            if (value != defaultValue)
+                out << " " << name << "='" << value << "' ";
         }
 
-        static std::string Serializer::SerializeAttribute(std::string name, Vector2 value)
+        static void SerializeAttribute(SerialWriter &out, const char *name, Vector2 value)
         {
-            std::string sub = " " + name + "='";
-            sub += value.x + ",";
-            sub += value.y;
-            sub += "' ";
-            return sub;
+            out << " " << name << "='" << value.x << "," << value.y << "' ";
         }
 
-        static std::string Serializer::SerializeAttribute(std::string name, Vector4 value)
+        static void SerializeAttribute(SerialWriter &out, const char *name, Vector4 value)
         {
-            std::string sub = " " + name + "='";
-            sub += value.x + ",";
-            sub += value.y + ",";
-            sub += value.z + ",";
-            sub += value.w;
-            sub += "' ";
-            return sub;
+            out << " " << name << "='" << value.x << "," << value.y << "," << value.z << "," << value.w << "' ";
         }
 
         static pugi::xml_document ParseXML(std::string inText);
 
         static bool LoadSerialFromXML(std::string path, bool keepOld = false);
         static bool LoadSerial(pugi::xml_document* doc, bool keepOld = false);
+        // Swaps the state for a saved one. Assets already resident stay as they are.
+        static bool LoadSavedState(std::shared_ptr<pugi::xml_document> doc);
         static bool LoadDependencies(pugi::xml_node node);
         static bool LoadSerialAssets(pugi::xml_node node);
         static void LoadSerialAsset(pugi::xml_node node);
 
         static void LoadSerialState();
 
+        // Asset loading runs in the background, the state is parsed once it is done
+        static bool IsLoading();
+        static void UpdateLoading();
+        static void FinishLoading();
+
         static void ParseTemplateClasses(pugi::xml_node node);
+        // Applies the registered template for every element with a class, in one walk
         static void ApplyTemplateClasses(pugi::xml_node node);
-        static void TryToApplyTemplate(pugi::xml_node templateNode, pugi::xml_node candidateNode);
         static void ApplyTemplate(pugi::xml_node templateNode, pugi::xml_node candidateNode);
 
-        static void ParseButtons(pugi::xml_node node);
-        static void ParseSprites(pugi::xml_node node);
+        static void ParseButtons(const std::vector<pugi::xml_node> &newButtons);
+        static void ParseSprites(const std::vector<pugi::xml_node> &newSprites);
         static void ParseActions(pugi::xml_node spriteNode, std::shared_ptr<Sprite> sprite);
-        static void ParseCharacters(pugi::xml_node node);
-        static void ParseFighters(pugi::xml_node node);
-        static void ParseRooms(pugi::xml_node node);
-        static void ParseGameState(pugi::xml_node node);
+        static void ParseCharacters(const std::vector<pugi::xml_node> &newChars);
+        static void ParseFighters(const std::vector<pugi::xml_node> &newFighters);
+        static void ParseRooms(const std::vector<pugi::xml_node> &newRooms);
+        static void ParseGameState(const std::vector<pugi::xml_node> &newGameStates);
         static void ParseHud(pugi::xml_node node);
         static void ParseDialoger(pugi::xml_node node);
         static void ParseDialogSprites(pugi::xml_node node);
@@ -84,7 +102,7 @@ namespace SBURB {
 
         static void SerialLoadDialogSprites(pugi::xml_node dialogSprites);
         static void SerialLoadEffects(pugi::xml_node effectsNode);
-        static void SerialLoadRoomSprites(std::shared_ptr<Room> newRoom, std::vector<pugi::xml_node> roomSprites);
+        static void SerialLoadRoomSprites(std::shared_ptr<Room> newRoom, const std::vector<pugi::xml_node> &roomSprites);
         static void SerialLoadRoomPaths(std::shared_ptr<Room> newRoom, pugi::xml_node pathsNode);
         static void SerialLoadRoomTriggers(std::shared_ptr<Room> newRoom, pugi::xml_node triggersNode);
     };
@@ -0,0 +1,43 @@
+#ifndef SBURB_SIGNALS_H
+#define SBURB_SIGNALS_H
+
+#include "Common.h"
+
+namespace SBURB
+{
+    // Things trigger events depend on. Whatever changes one publishes it, and triggers only get
+    // evaluated again once something they depend on was published since their last check.
+    enum Signal : uint32_t
+    {
+        SignalNone = 0,
+        SignalGameState = 1 << 0,
+        // A sprite moved or changed animation, or the player switched characters
+        SignalSprites = 1 << 1,
+        // An action queue started, advanced or finished
+        SignalQueues = 1 << 2,
+        SignalInput = 1 << 3,
+        // A tick scheduled on the timer wheel came up
+        SignalTimer = 1 << 4,
+        // Anything else, polled every tick
+        SignalAlways = 1 << 5,
+        SignalCount = 6
+    };
+
+    class Signals
+    {
+    public:
+        static void Publish(uint32_t signals);
+
+        // Stamps are ordered, anything published later gets a bigger one
+        static uint64_t Now();
+        static bool Since(uint32_t signals, uint64_t stamp);
+
+        // Timer wheel on the tick count, SignalTimer goes out when a scheduled tick is reached
+        static void Schedule(uint32_t tick);
+        static void Advance(uint32_t tick);
+
+        static void Clear();
+    };
+}
+
+#endif
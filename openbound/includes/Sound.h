@@ -30,6 +30,8 @@ namespace SBURB
 
         sf::Sound asset;
         std::shared_ptr<AssetAudio> audio;
+        // Held from Play until Stop so the buffer can't be evicted mid sound
+        std::shared_ptr<sf::SoundBuffer> buffer;
     };
 }
 
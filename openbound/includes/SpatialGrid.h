@@ -0,0 +1,72 @@
+#ifndef SBURB_SPATIAL_GRID_H
+#define SBURB_SPATIAL_GRID_H
+
+#include "Common.h"
+
+#include <unordered_map>
+
+namespace SBURB
+{
+    // Uniform grid over a room so collision and action queries only look at nearby sprites.
+    // Sprites are bucketed by their collision box merged with their visual frame, anything
+    // outside the room is clamped into the border cells.
+    class SpatialGrid
+    {
+    public:
+        SpatialGrid(int width, int height);
+        ~SpatialGrid();
+
+        void Resize(int width, int height);
+
+        void Insert(std::shared_ptr<Sprite> sprite);
+        bool Remove(Sprite *sprite);
+        void Move(Sprite *sprite);
+        void Clear();
+        bool Contains(Sprite *sprite) const { return this->entries.find(sprite) != this->entries.end(); };
+
+        // Query results come back sorted on this, rooms use their depth order
+        void SetOrder(Sprite *sprite, int order);
+
+        // Every sprite whose cells touch the inclusive rect, ordered. Results are appended.
+        void Query(int left, int top, int right, int bottom, std::vector<std::shared_ptr<Sprite>> &results);
+
+        int GetCellSize() const { return this->cellSize; };
+
+    private:
+        struct CellRange
+        {
+            int left;
+            int top;
+            int right;
+            int bottom;
+
+            bool operator==(const CellRange &other) const { return left == other.left && top == other.top && right == other.right && bottom == other.bottom; };
+        };
+
+        struct Entry
+        {
+            std::shared_ptr<Sprite> sprite;
+            CellRange range;
+            int order;
+            unsigned int stamp;
+        };
+
+        CellRange CellsFor(int left, int top, int right, int bottom) const;
+        CellRange CellsFor(Sprite *sprite) const;
+        void Link(Entry *entry);
+        void Unlink(Entry *entry);
+
+        int width;
+        int height;
+        int cellSize;
+        int cols;
+        int rows;
+        unsigned int stamp;
+
+        std::vector<std::vector<Entry *>> cells;
+        std::unordered_map<Sprite *, Entry> entries;
+        std::vector<Entry *> found;
+    };
+}
+
+#endif
@@ -7,9 +7,12 @@
 #include "Animation.h"
 #include "Action.h"
 #include "Room.h"
+#include "Signals.h"
 
 namespace SBURB
 {
+    class SpatialGrid;
+
     enum class Depth : int {
         BG_DEPTHING = 0,
         MG_DEPTHING = 1,
@@ -36,25 +39,40 @@ namespace SBURB
         void AddAction(std::shared_ptr<Action> action);
         void RemoveAction(std::string name);
         std::vector<std::shared_ptr<Action>> GetActions(std::shared_ptr<Sprite> sprite);
+        // Unfiltered, whoever the actions are meant for
+        const std::vector<std::shared_ptr<Action>> &GetAllActions() { return this->actions; };
 
-        std::map<std::string, Vector2> GetBoundaryQueries(int dx, int dy);
+        virtual void GetBoundaryQueries(BoundaryQuery &query, int dx = 0, int dy = 0);
 
         std::shared_ptr<Sprite> Clone(std::string name);
-        std::string Serialize(std::string output);
+        virtual void Serialize(SerialWriter &out);
 
         std::string GetName() { return this->name; };
+        // Name of the animation it was last told to start
+        std::string GetState() { return this->state; };
         bool GetCollidable() { return this->collidable; };
         int GetWidth() { return this->width; };
         int GetHeight() { return this->height; };
 
         void SetDepthing(int depthing) { this->depthing = depthing; };
+        int GetDepthing() { return this->depthing; };
+
+        // World space rect covered by the current animation
+        sf::FloatRect GetBounds() const;
+
+        // Background sprites that never change frame can live in a cached vertex buffer
+        bool IsStatic() { return this->depthing == static_cast<int>(Depth::BG_DEPTHING) && this->animation && this->animation->IsStatic(); };
 
-        void SetX(int x) { this->x = x; this->setPosition(this->x, this->y); };
+        void SetX(int x) { this->x = x; this->setPosition(this->x, this->y); this->UpdateGrids(); Signals::Publish(SignalSprites); };
         int GetX() { return this->x; };
 
-        void SetY(int y) { this->y = y; this->setPosition(this->x, this->y); };
+        void SetY(int y) { this->y = y; this->setPosition(this->x, this->y); this->UpdateGrids(); Signals::Publish(SignalSprites); };
         int GetY() { return this->y; };
 
+        // Room grids this sprite is indexed in, they get told whenever it moves
+        void AttachGrid(SpatialGrid *grid);
+        void DetachGrid(SpatialGrid *grid);
+
         std::string GetProp(std::string prop);
 
     protected:
@@ -72,7 +90,9 @@ namespace SBURB
         std::string state;
         int lastTime;
         std::vector<std::shared_ptr<Action>> actions;
-        std::map<std::string, Vector2> queries;
+        std::vector<SpatialGrid *> grids;
+
+        void UpdateGrids();
 
     private:
         virtual void draw(sf::RenderTarget &target, sf::RenderStates states) const;
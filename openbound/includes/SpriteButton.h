@@ -21,7 +21,7 @@ namespace SBURB
 
         void SetAction(std::shared_ptr<Action> action) { this->action = action; };
 
-        std::string Serialize(std::string output);
+        void Serialize(SerialWriter &out);
 
     protected:
         std::shared_ptr<AssetGraphic> sheet;
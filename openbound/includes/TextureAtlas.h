@@ -0,0 +1,25 @@
+#ifndef SBURB_TEXTURE_ATLAS_H
+#define SBURB_TEXTURE_ATLAS_H
+
+#include "Common.h"
+#include "AssetGraphic.h"
+
+#include <vector>
+
+namespace SBURB
+{
+    // Packs small graphics into a few large pages so the batcher can draw many sheets in one call.
+    class TextureAtlas
+    {
+    public:
+        static void Register(std::shared_ptr<AssetGraphic> graphic);
+        static void PackPending();
+        static void Clear();
+
+        static int GetPageCount();
+        // Pages can't be evicted, they still count towards the memory budget
+        static size_t GetResidentSize();
+    };
+}
+
+#endif
@@ -13,13 +13,25 @@ namespace SBURB {
         ~Trigger();
 
         void Reset();
+        // Stops and restarts the clocks of timed events, for triggers in rooms that aren't the current one
+        void Pause();
+        void Resume();
         bool CheckCompletion();
+        // CheckCompletion, but only redone when something the events depend on changed since the last time
+        bool Evaluate();
         bool TryToTrigger();
-        std::string Serialize(std::string output);
+        void Serialize(SerialWriter &out);
 
         void SetFollowUp(std::shared_ptr<Trigger> followUp) { this->followUp = followUp; };
 
         void SetDetonate(bool shouldDetonate) { this->shouldDetonate = shouldDetonate; };
+
+        std::shared_ptr<Action> GetAction() { return this->action; };
+
+        // Everything that can change the outcome of TryToTrigger, the follow up chain included
+        uint32_t GetSignals();
+        // Set when the trigger has to be looked at again whether or not anything was published
+        bool IsDirty() { return this->dirty; };
         
     protected:
         std::vector<std::string> info;
@@ -31,6 +43,11 @@ namespace SBURB {
         std::shared_ptr<Trigger> waitFor;
         std::vector<std::shared_ptr<Event>> events;
 
+        uint32_t signals;
+        uint64_t checkedAt;
+        bool dirty;
+        bool completed;
+
     };
 }
 #endif
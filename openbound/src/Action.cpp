@@ -1,9 +1,63 @@
 #include "Action.h"
+#include "CommandHandler.h"
+
+#include <cstdlib>
 
 namespace SBURB {
+    static const std::string emptyParam = "";
+
+    ActionArgs::ActionArgs(const std::string &info) {
+        this->text = trim(info);
+
+        size_t start = 0;
+        while (true) {
+            size_t end = this->text.find(',', start);
+
+            Param param;
+            param.value = trim(this->text.substr(start, end == std::string::npos ? std::string::npos : end - start));
+            param.number = (int)std::strtol(param.value.c_str(), nullptr, 10);
+            param.real = std::strtof(param.value.c_str(), nullptr);
+            param.offset = start;
+            param.sprite = SpriteRef(param.value);
+            param.room = RoomRef(param.value);
+            this->params.push_back(param);
+
+            if (end == std::string::npos) {
+                break;
+            }
+            start = end + 1;
+        }
+    }
+
+    const std::string &ActionArgs::Get(size_t index) const {
+        return index < this->params.size() ? this->params[index].value : emptyParam;
+    }
+
+    int ActionArgs::GetInt(size_t index) const {
+        return index < this->params.size() ? this->params[index].number : 0;
+    }
+
+    float ActionArgs::GetFloat(size_t index) const {
+        return index < this->params.size() ? this->params[index].real : 0;
+    }
+
+    std::shared_ptr<Sprite> ActionArgs::GetSprite(size_t index) const {
+        return index < this->params.size() ? this->params[index].sprite.Get() : nullptr;
+    }
+
+    std::shared_ptr<Room> ActionArgs::GetRoom(size_t index) const {
+        return index < this->params.size() ? this->params[index].room.Get() : nullptr;
+    }
+
+    std::string ActionArgs::GetFrom(size_t index) const {
+        return index < this->params.size() ? trim(this->text.substr(this->params[index].offset)) : "";
+    }
+
     Action::Action(std::string command, std::string info, std::string name, std::string sprite, std::shared_ptr<Action> followUp, bool noWait, bool noDelay, uint16_t times, bool soft, std::string silent) {
         this->command = command;
+        this->commandId = CommandHandler::GetCommandId(command);
         this->info = info;
+        this->args = std::make_shared<ActionArgs>(info);
 
         this->silentCause = silent;
         
@@ -28,27 +82,35 @@ namespace SBURB {
     }
 
     std::shared_ptr<Action> Action::Clone() {
-        return std::make_shared<Action>(this->command, this->info, this->name, this->sprite, this->followUp, this->noWait, this->noDelay, this->times, this->soft, this->silentCause);
+        // A plain copy, the command id and parsed arguments come along instead of being redone
+        return std::make_shared<Action>(*this);
     }
 
-    std::string Action::Serialize(std::string output) {
-        std::string newOutput = output + "\n<action " +
-            "command='" + this->command +
-            (this->sprite != "" ? "' sprite='" + this->sprite : "") +
-            (this->name != "" ? "' name='" + this->name : "") +
-            (this->noWait ? "' noWait='" + this->noWait : "") +
-            (this->noDelay ? "' noDelay='" + this->noDelay : "") +
-            (this->soft ? "' soft='" + this->soft : "") +
-            (this->silentCause != "" ? "' silent='" + this->silentCause : "") +
-            (this->times != 1 ? "' times='" + this->times : "") +
-            "'>";
+    void Action::Serialize(SerialWriter &out) {
+        out << "\n<action " << "command='" << this->command;
+        if (this->sprite != "")
+            out << "' sprite='" << this->sprite;
+        if (this->name != "")
+            out << "' name='" << this->name;
+        if (this->noWait)
+            out << "' noWait='true";
+        if (this->noDelay)
+            out << "' noDelay='true";
+        if (this->soft)
+            out << "' soft='true";
+        if (this->silentCause != "")
+            out << "' silent='" << this->silentCause;
+        if (this->times != 1)
+            out << "' times='" << (int)this->times;
+        out << "'>";
 
-        newOutput += (this->info != "" ? "<args>" + this->info + "</args>" : "");
+        if (this->info != "")
+            out << "<args>" << this->info << "</args>";
 
         if (this->followUp.get() != NULL) {
-            newOutput = this->followUp.get()->Serialize(newOutput);
+            this->followUp.get()->Serialize(out);
         }
 
-        return newOutput;
+        out << "</action>";
     }
 }
\ No newline at end of file
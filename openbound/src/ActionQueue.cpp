@@ -19,6 +19,8 @@ namespace SBURB {
         this->noWait = noWait;
         this->isPaused = isPaused;
         this->trigger = trigger;
+
+        Signals::Publish(SignalQueues);
     }
 
     ActionQueue::~ActionQueue() {
@@ -35,30 +37,31 @@ namespace SBURB {
 		return false;
 	}
 
-    std::string ActionQueue::Serialize(std::string output) {
+    void ActionQueue::Serialize(SerialWriter &out) {
 
 		if (this->curAction.get() == NULL) {
-			return "";
+			return;
 		}
 
-		std::string groupString = "";
+		out << "\n<actionQueue " <<
+			"id='" << this->id <<
+			"' noWait='" << (this->noWait ? "true" : "false") <<
+			"' paused='" << (this->isPaused ? "true" : "false") << "'";
+
 		for (int i = 0; i < this->groups.size(); i++) {
-			groupString += ((i > 0) ? ":" : "") + this->groups[i];
+			out << (i > 0 ? ":" : " groups='") << this->groups[i];
+		}
+		if (!this->groups.empty()) {
+			out << "'";
 		}
 
-		std::string newOutput = output + "\n<actionQueue " + ">";
-			"id = '" + this->id +
-			"' noWait='" + std::to_string(this->noWait) +
-			"' paused='" + std::to_string(this->isPaused) + "'" +
-			(groupString.length() == 0 ? "" : " groups='" + groupString + "'") +
-			">";
+		out << ">";
 
-		newOutput = this->curAction.get()->Serialize(newOutput);
+		this->curAction.get()->Serialize(out);
 		if (this->trigger.get() != NULL) {
-			newOutput = this->trigger.get()->Serialize(newOutput);
+			this->trigger.get()->Serialize(out);
 		}
 
-		newOutput += "</actionQueue>";
-		return newOutput;
+		out << "</actionQueue>";
     }
 }
\ No newline at end of file
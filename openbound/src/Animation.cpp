@@ -28,33 +28,25 @@ namespace SBURB
 			this->numCols = numCols;
 			this->rowSize = rowSize;
 			this->colSize = colSize;
-			this->sheets = {};
+			this->sheets.assign(this->numCols * this->numRows, nullptr);
 
+			// Resolve the tile names once here, drawing only deals with handles
 			for (int colNum = 0; colNum < this->numCols; colNum++)
 			{
 				for (int rowNum = 0; rowNum < this->numRows; rowNum++)
 				{
-					std::shared_ptr<AssetGraphic> texture = AssetManager::GetGraphicByName(sheetName + "_" + std::to_string(colNum) + "_" + std::to_string(rowNum));
-
-					if (texture)
-					{
-						if (this->sheets.find(colNum) == this->sheets.end())
-						{
-							this->sheets[colNum] = {};
-						}
-
-						this->sheets[colNum][rowNum] = texture;
-					}
+					int handle = AssetManager::GetGraphicHandle(sheetName + "_" + std::to_string(colNum) + "_" + std::to_string(rowNum));
+					this->sheets[colNum * this->numRows + rowNum] = AssetManager::GetGraphicByHandle(handle);
 				}
 			}
 		}
 		else
 		{
 			this->sheet = AssetManager::GetGraphicByName(sheetName);
-			this->rowSize = rowSize ? rowSize : this->sheet->GetAsset()->getSize().y;
-			this->colSize = colSize ? colSize : this->sheet->GetAsset()->getSize().x;
-			this->numRows = this->sheet->GetAsset()->getSize().y / this->rowSize;
-			this->numCols = this->sheet->GetAsset()->getSize().x / this->colSize;
+			this->rowSize = rowSize ? rowSize : this->sheet->GetSize().y;
+			this->colSize = colSize ? colSize : this->sheet->GetSize().x;
+			this->numRows = this->sheet->GetSize().y / this->rowSize;
+			this->numCols = this->sheet->GetSize().x / this->colSize;
 		}
 
 		if (frameInterval == "")
@@ -131,30 +123,70 @@ namespace SBURB
 		}
 	}
 
+	void Animation::CollectSheets(std::vector<std::shared_ptr<Asset>>& sheets)
+	{
+		if (this->sheet)
+			sheets.push_back(this->sheet);
+
+		for (auto& slice : this->sheets)
+		{
+			if (slice)
+				sheets.push_back(slice);
+		}
+	}
+
+	sf::FloatRect Animation::GetBounds() const
+	{
+		sf::FloatRect local(0, 0, this->colSize, this->rowSize);
+		if (this->sliced)
+		{
+			local.width *= this->numCols;
+			local.height *= this->numRows;
+		}
+
+		return getTransform().transformRect(local);
+	}
+
 	void Animation::draw(sf::RenderTarget &target, sf::RenderStates states) const
 	{
 		states.transform *= getTransform();
 
 		if (this->sliced)
 		{
-			// TODO: Keep inside of camera view for optimization??? May not be necessary.
+			const BatchHandler &batcher = BatchHandler::getInstance();
+			int firstCol = 0, lastCol = this->numCols - 1;
+			int firstRow = 0, lastRow = this->numRows - 1;
 
-			for (int colNum = 0; colNum < this->numCols; colNum++)
+			// Only walk the tiles under the camera. Tiles can be a little larger than the grid, so pad by one.
+			if (batcher.IsCulling() && this->colSize > 0 && this->rowSize > 0)
 			{
-				for (int rowNum = 0; rowNum < this->numRows; rowNum++)
+				sf::FloatRect view = states.transform.getInverse().transformRect(batcher.GetCullRect());
+				firstCol = std::max(firstCol, (int)std::floor(view.left / this->colSize) - 1);
+				lastCol = std::min(lastCol, (int)std::floor((view.left + view.width) / this->colSize));
+				firstRow = std::max(firstRow, (int)std::floor(view.top / this->rowSize) - 1);
+				lastRow = std::min(lastRow, (int)std::floor((view.top + view.height) / this->rowSize));
+			}
+
+			for (int colNum = firstCol; colNum <= lastCol; colNum++)
+			{
+				for (int rowNum = firstRow; rowNum <= lastRow; rowNum++)
 				{
-					if (this->sheets.find(colNum) != this->sheets.end() && this->sheets.at(colNum).find(rowNum) != this->sheets.at(colNum).end())
+					const std::shared_ptr<AssetGraphic> &sheet = this->sheets[colNum * this->numRows + rowNum];
+
+					if (sheet)
 					{
-						std::shared_ptr<AssetGraphic> sheet = this->sheets.at(colNum).at(rowNum);
-						int frameX = 0;
-						int frameY = 0;
-						int drawWidth = sheet->GetAsset()->getSize().x;
-						int drawHeight = sheet->GetAsset()->getSize().y;
+						int frameX = sheet->GetAtlasOffset().x;
+						int frameY = sheet->GetAtlasOffset().y;
+						int drawWidth = sheet->GetSize().x;
+						int drawHeight = sheet->GetSize().y;
 						int offsetX = colNum * this->colSize;
 						int offsetY = rowNum * this->rowSize;
 
 						sf::FloatRect transformRect(offsetX, offsetY, drawWidth, drawHeight);
 						transformRect = states.transform.transformRect(transformRect);
+						if (batcher.IsCulled(transformRect))
+							continue;
+
 						sf::VertexArray arr(sf::Quads, 4);
 						arr[0].position = sf::Vector2f(transformRect.left, transformRect.top);
 						arr[1].position = sf::Vector2f(transformRect.left + transformRect.width, transformRect.top);
@@ -171,7 +203,7 @@ namespace SBURB
 						arr[2].color = sf::Color::White;
 						arr[3].color = sf::Color::White;
 
-						BatchHandler::getInstance().DrawSpriteRect(this->sheetName + "_" + std::to_string(colNum) + "_" + std::to_string(rowNum), arr, target);
+						BatchHandler::getInstance().DrawSpriteRect(sheet->GetHandle(), arr, target);
 					}
 				}
 			}
@@ -180,8 +212,8 @@ namespace SBURB
 		{
 			int colNum = ((this->startPos + this->curFrame) % this->numCols);
 			int rowNum = (floor((this->startPos + this->curFrame - colNum) / this->numCols));
-			int frameX = colNum * this->colSize;
-			int frameY = rowNum * this->rowSize;
+			int frameX = colNum * this->colSize + this->sheet->GetAtlasOffset().x;
+			int frameY = rowNum * this->rowSize + this->sheet->GetAtlasOffset().y;
 			int drawWidth = this->colSize;
 			int drawHeight = this->rowSize;
 
@@ -203,7 +235,7 @@ namespace SBURB
 			arr[2].color = sf::Color::White;
 			arr[3].color = sf::Color::White;
 
-			BatchHandler::getInstance().DrawSpriteRect(this->sheetName, arr, target);
+			BatchHandler::getInstance().DrawSpriteRect(this->sheet->GetHandle(), arr, target);
 		}
 	}
 
@@ -235,14 +267,14 @@ namespace SBURB
 	void Animation::SetColSize(int newSize)
 	{
 		this->colSize = newSize;
-		this->numCols = this->sheet->GetAsset()->getSize().x / this->colSize;
+		this->numCols = this->sheet->GetSize().x / this->colSize;
 		Reset();
 	}
 
 	void Animation::SetRowSize(int newSize)
 	{
 		this->rowSize = newSize;
-		this->numRows = this->sheet->GetAsset()->getSize().y / this->rowSize;
+		this->numRows = this->sheet->GetSize().y / this->rowSize;
 		Reset();
 	}
 
@@ -275,41 +307,44 @@ namespace SBURB
 		return std::make_shared<Animation>(this->name, this->sheetName, x + this->x, y + this->y, this->colSize, this->rowSize, this->startPos, this->length, std::to_string(this->frameInterval), this->loopNum, this->followUp, this->flipX, this->flipY, this->sliced, this->numCols, this->numRows);
 	}
 
-	std::string Animation::Serialize(std::string output)
+	void Animation::Serialize(SerialWriter &out)
 	{
-		std::string frameInterval = "";
-		bool firstInterval = true;
+		out << "\n<animation " << "sheet='" << this->sheetName << "' ";
+		if (this->name != "image")
+			out << "name='" << this->name << "' ";
+		Serializer::SerializeAttribute(out, "x", this->x);
+		Serializer::SerializeAttribute(out, "y", this->y);
+		if (this->rowSize != this->sheet->GetSize().y)
+			out << "rowSize='" << this->rowSize << "' ";
+		if (this->colSize != this->sheet->GetSize().x)
+			out << "colSize='" << this->colSize << "' ";
+		Serializer::SerializeAttribute(out, "startPos", this->startPos);
+		if (this->length != 1)
+			out << "length='" << this->length << "' ";
 
 		if (!this->frameIntervals.empty())
 		{
+			bool firstInterval = true;
+			out << "frameInterval='";
 			for (std::pair<int, int> interval : this->frameIntervals)
 			{
-				frameInterval = frameInterval + (firstInterval ? "" : ",") + std::to_string(interval.first) + ":" + std::to_string(interval.second);
+				out << (firstInterval ? "" : ",") << interval.first << ":" << interval.second;
 				firstInterval = false;
 			}
+			out << "' ";
 		}
 		else if (this->frameInterval != 1)
 		{
-			frameInterval = this->frameInterval;
+			out << "frameInterval='" << this->frameInterval << "' ";
 		}
 
-		output = output + "\n<animation " +
-				 ("sheet='" + this->sheetName + "' ") +
-				 ((this->name != "image") ? "name='" + this->name + "' " : "") +
-				 Serializer::SerializeAttribute("x", this->x) +
-				 Serializer::SerializeAttribute("y", this->y) +
-				 ((this->rowSize != this->sheet->GetAsset()->getSize().y) ? "rowSize='" + std::to_string(this->rowSize) + "' " : "") +
-				 ((this->colSize != this->sheet->GetAsset()->getSize().x) ? "colSize='" + std::to_string(this->colSize) + "' " : "") +
-				 Serializer::SerializeAttribute("startPos", this->startPos) +
-				 ((this->length != 1) ? "length='" + std::to_string(this->length) + "' " : "") +
-				 ((frameInterval != "") ? "frameInterval='" + frameInterval + "' " : "") +
-				 ((this->loopNum != -1) ? "loopNum='" + std::to_string(this->loopNum) + "' " : "") +
-				 Serializer::SerializeAttribute("followUp", this->followUp) +
-				 Serializer::SerializeAttribute("flipX", this->flipX) +
-				 Serializer::SerializeAttribute("flipY", this->flipY) +
-				 (this->sliced ? ("sliced='true' numCols='" + std::to_string(this->numCols) + "' numRows='" + std::to_string(this->numRows) + "' ") : ("")) +
-				 " />";
-
-		return output;
+		if (this->loopNum != -1)
+			out << "loopNum='" << this->loopNum << "' ";
+		Serializer::SerializeAttribute(out, "followUp", this->followUp);
+		Serializer::SerializeAttribute(out, "flipX", this->flipX);
+		Serializer::SerializeAttribute(out, "flipY", this->flipY);
+		if (this->sliced)
+			out << "sliced='true' numCols='" << this->numCols << "' numRows='" << this->numRows << "' ";
+		out << " />";
 	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "AssetAudio.h"
 #include "Sburb.h"
+#include "Logger.h"
 
 namespace SBURB {
     AssetAudio::AssetAudio(std::string name, std::vector<std::string> sources) {
@@ -7,6 +8,46 @@ namespace SBURB {
         this->name = name;
         this->sources = sources;
         this->asset = std::make_shared<sf::SoundBuffer>();
-        this->asset->loadFromFile(Sburb::ResolvePath(sources[0]));
+        this->resident = false;
+        this->loaded = false;
+    }
+
+    void AssetAudio::ResolvePaths() {
+        this->resolvedSource = this->sources.empty() ? "" : Sburb::ResolvePath(this->sources[0]);
+    }
+
+    bool AssetAudio::Decode() {
+        if (this->resolvedSource.empty() || !this->asset->loadFromFile(this->resolvedSource)) {
+            GlobalLogger->Log(Logger::Error, "Failed to load audio " + this->name + ".");
+            return false;
+        }
+
+        this->resident = true;
+        return true;
+    }
+
+    size_t AssetAudio::GetResidentSize() {
+        return this->resident ? this->asset->getSampleCount() * sizeof(sf::Int16) : 0;
+    }
+
+    bool AssetAudio::Evict() {
+        // Sounds hold on to the buffer while they play, cutting them off would be audible
+        if (!this->resident || this->asset.use_count() > 1) {
+            return false;
+        }
+
+        this->asset = std::make_shared<sf::SoundBuffer>();
+        this->resident = false;
+        return true;
+    }
+
+    std::shared_ptr<sf::SoundBuffer> AssetAudio::GetAsset() {
+        if (!this->resident && this->loaded) {
+            GlobalLogger->Log(Logger::Info, "Reloading evicted audio " + this->name + ".");
+            this->Decode();
+        }
+
+        this->Touch();
+        return this->asset;
     }
 }
\ No newline at end of file
@@ -8,14 +8,28 @@ namespace SBURB {
         this->name = name;
         this->sources = sources;
         this->asset = std::make_shared<sf::Font>();
+        this->loaded = false;
+    }
 
-        for (int i = 0; i < sources.size(); i++) {
-            auto values = split(sources[i], ":");
+    void AssetFont::ResolvePaths() {
+        this->resolvedSources.clear();
+        for (int i = 0; i < this->sources.size(); i++) {
+            auto values = split(this->sources[i], ":");
             auto type = trim(values[0]);
-            auto path = trim(values[1]);
+            auto path = values.size() > 1 ? trim(values[1]) : "";
+
+            this->resolvedSources.push_back({type, type == "url" ? Sburb::ResolvePath(path) : path});
+        }
+    }
+
+    bool AssetFont::Decode() {
+        for (int i = 0; i < this->resolvedSources.size(); i++) {
+            auto type = this->resolvedSources[i].first;
+            auto path = this->resolvedSources[i].second;
 
             if (type == "url") {
-                auto extension = path.substr(path.find(".") + 1, path.size() - (path.find(".") + 1));
+                // From the last dot, the resource path in front may have dots of its own
+                auto extension = path.substr(path.rfind(".") + 1);
                 auto format = "";
 
                 if (extension == "ttf") {
@@ -31,9 +45,9 @@ namespace SBURB {
                 if (format == "truetype" || format == "woff") {
                     // NOTE: UNSURE IF WOFF IS SUPPORTED?????
 
-                    if (!this->asset->loadFromFile(Sburb::ResolvePath(path))) {
-                        GlobalLogger->Log(Logger::Error, "Failed to create main game window.");
-                        return;
+                    if (!this->asset->loadFromFile(path)) {
+                        GlobalLogger->Log(Logger::Error, "Failed to load font " + this->name + " from " + path);
+                        return false;
                     }
                 }
             }
@@ -46,5 +60,7 @@ namespace SBURB {
                 //ret.extra += "font-weight:" + path + "; "
             }
         }
+
+        return true;
     }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "AssetGraphic.h"
 #include "Sburb.h"
+#include "Logger.h"
 
 namespace SBURB {
     AssetGraphic::AssetGraphic(std::string name, std::string path) {
@@ -7,6 +8,140 @@ namespace SBURB {
         this->name = name;
         this->path = path;
         this->asset = std::make_shared<sf::Texture>();
-        this->asset->loadFromFile(Sburb::ResolvePath(path));
+        this->handle = -1;
+        this->atlasPage = nullptr;
+        this->atlasOffset = {0, 0};
+        this->walkMask = nullptr;
+        this->walkable = false;
+        this->size = {0, 0};
+        this->resident = false;
+        this->loaded = false;
     }
-}
\ No newline at end of file
+
+    void AssetGraphic::ResolvePaths() {
+        this->resolvedPath = Sburb::ResolvePath(this->path);
+    }
+
+    bool AssetGraphic::Decode() {
+        if (!this->pixels.loadFromFile(this->resolvedPath)) {
+            GlobalLogger->Log(Logger::Error, "Failed to load graphic " + this->name + " from " + this->path);
+            return false;
+        }
+
+        this->size = this->pixels.getSize();
+
+        if (this->walkable && !this->walkMask) {
+            this->BuildWalkMask(this->pixels);
+        }
+
+        return true;
+    }
+
+    void AssetGraphic::Upload() {
+        if (this->walkable) {
+            // Marked after it was decoded, the pixels are still here to build it from
+            if (!this->walkMask && this->size.x > 0 && this->size.y > 0) {
+                this->BuildWalkMask(this->pixels);
+            }
+        }
+        else {
+            this->UploadTexture();
+        }
+
+        this->pixels = sf::Image();
+    }
+
+    void AssetGraphic::UploadTexture() {
+        // No GL context when headless, only the dimensions matter there
+        if (!Sburb::GetInstance()->IsHeadless() && this->size.x > 0 && this->size.y > 0) {
+            this->resident = this->asset->loadFromImage(this->pixels);
+        }
+    }
+
+    size_t AssetGraphic::GetResidentSize() {
+        return this->resident ? (size_t)this->size.x * this->size.y * 4 : 0;
+    }
+
+    bool AssetGraphic::Evict() {
+        if (!this->resident) {
+            return false;
+        }
+
+        // Swap in a fresh texture rather than touching the old one, anything still holding it stays valid
+        this->asset = std::make_shared<sf::Texture>();
+        this->resident = false;
+        return true;
+    }
+
+    void AssetGraphic::Restore() {
+        // Evicted graphics were loaded once already, so the size is known and only the texture is missing
+        if (this->resident || !this->loaded || Sburb::GetInstance()->IsHeadless() || this->size.x == 0 || this->size.y == 0) {
+            return;
+        }
+
+        GlobalLogger->Log(Logger::Info, "Reloading evicted graphic " + this->name + ".");
+        if (this->Decode()) {
+            this->UploadTexture();
+            this->pixels = sf::Image();
+        }
+    }
+
+    std::shared_ptr<sf::Texture> AssetGraphic::GetAsset() {
+        this->Restore();
+        this->Touch();
+        return this->asset;
+    }
+
+    std::shared_ptr<sf::Texture> AssetGraphic::GetTexture() {
+        this->Touch();
+
+        // Packed graphics draw from the page, their own texture isn't needed for that
+        if (this->atlasPage) {
+            return this->atlasPage;
+        }
+
+        this->Restore();
+        return this->asset;
+    }
+
+    sf::Image AssetGraphic::CopyToImage() {
+        if (Sburb::GetInstance()->IsHeadless() || !this->resident) {
+            sf::Image image;
+            image.loadFromFile(this->resolvedPath);
+            return image;
+        }
+
+        return this->asset->copyToImage();
+    }
+
+    std::shared_ptr<const BitMask> AssetGraphic::GetWalkMask() {
+        if (this->walkMask) {
+            return this->walkMask;
+        }
+
+        // Not marked when it was loaded. Straight from the file, reading the texture back from the GPU stalls
+        sf::Image image;
+        if (!image.loadFromFile(this->resolvedPath)) {
+            GlobalLogger->Log(Logger::Error, "Failed to load walkable map " + this->name + " from " + this->path);
+            return nullptr;
+        }
+
+        this->BuildWalkMask(image);
+        return this->walkMask;
+    }
+
+    void AssetGraphic::BuildWalkMask(const sf::Image &image) {
+        sf::Vector2u imageSize = image.getSize();
+        const sf::Uint8* pixels = image.getPixelsPtr();
+        this->walkMask = std::make_shared<BitMask>(imageSize.x, imageSize.y);
+
+        for (unsigned int y = 0; y < imageSize.y; y++) {
+            for (unsigned int x = 0; x < imageSize.x; x++) {
+                const sf::Uint8* pixel = pixels + (y * imageSize.x + x) * 4;
+                if (pixel[0] == 255 && pixel[1] == 255 && pixel[2] == 255 && pixel[3] == 255) {
+                    this->walkMask->Set(x, y, true);
+                }
+            }
+        }
+    }
+}
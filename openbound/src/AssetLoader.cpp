@@ -0,0 +1,167 @@
+#include "AssetLoader.h"
+#include "AssetManager.h"
+#include "Profiler.h"
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+
+constexpr unsigned int MAX_LOADER_THREADS = 4;
+
+namespace SBURB
+{
+    AssetLoader::AssetLoader()
+        : stopping(false), queuedCount(0), loadedCount(0)
+    {
+    }
+
+    AssetLoader::~AssetLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->jobReady.notify_all();
+
+        for (auto &worker : this->workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+    }
+
+    void AssetLoader::StartWorkers()
+    {
+        // Leave a core for the main thread
+        unsigned int count = std::thread::hardware_concurrency();
+        count = std::clamp(count > 1 ? count - 1 : 1, 1u, MAX_LOADER_THREADS);
+
+        for (unsigned int i = 0; i < count; i++)
+        {
+            this->workers.emplace_back(&AssetLoader::Work, this);
+        }
+    }
+
+    void AssetLoader::Queue(std::shared_ptr<Asset> asset)
+    {
+        if (!asset || asset->IsLoaded())
+            return;
+
+        if (this->workers.empty())
+            this->StartWorkers();
+
+        // Only on this thread, the resource path it depends on is changed by loads in progress
+        asset->ResolvePaths();
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+
+            // A fresh batch, restart the progress count
+            if (this->loadedCount == this->queuedCount)
+            {
+                this->queuedCount = 0;
+                this->loadedCount = 0;
+            }
+
+            this->pending.push_back(asset);
+            this->queuedCount++;
+        }
+        this->jobReady.notify_one();
+    }
+
+    void AssetLoader::Work()
+    {
+        while (true)
+        {
+            std::shared_ptr<Asset> asset;
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->jobReady.wait(lock, [this] { return this->stopping || !this->pending.empty(); });
+
+                if (this->stopping)
+                    return;
+
+                asset = this->pending.front();
+                this->pending.pop_front();
+            }
+
+            // Failures are logged by the asset, it still counts towards progress
+            asset->Decode();
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->decoded.push_back(asset);
+            }
+            this->jobDone.notify_all();
+        }
+    }
+
+    void AssetLoader::Complete(std::shared_ptr<Asset> asset)
+    {
+        asset->Upload();
+        asset->SetLoaded(true);
+        AssetManager::OnAssetLoaded(asset);
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->loadedCount++;
+    }
+
+    bool AssetLoader::Pump(sf::Time budget)
+    {
+        SBURB_PROFILE_SCOPE("AssetLoader::Pump");
+        sf::Clock clock;
+
+        while (budget <= sf::Time::Zero || clock.getElapsedTime() < budget)
+        {
+            std::shared_ptr<Asset> asset;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (this->decoded.empty())
+                    break;
+
+                asset = this->decoded.front();
+                this->decoded.pop_front();
+            }
+
+            this->Complete(asset);
+        }
+
+        return !this->IsLoading();
+    }
+
+    void AssetLoader::Finish()
+    {
+        while (this->IsLoading())
+        {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->jobDone.wait(lock, [this] { return !this->decoded.empty(); });
+            }
+
+            this->Pump(sf::Time::Zero);
+        }
+    }
+
+    bool AssetLoader::IsLoading()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->loadedCount != this->queuedCount;
+    }
+
+    float AssetLoader::GetProgress()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->queuedCount == 0 ? 1.0f : (float)this->loadedCount / this->queuedCount;
+    }
+
+    int AssetLoader::GetLoadedCount()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->loadedCount;
+    }
+
+    int AssetLoader::GetQueuedCount()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->queuedCount;
+    }
+}
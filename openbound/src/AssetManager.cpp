@@ -1,26 +1,195 @@
 #include "AssetManager.h"
+#include "TextureAtlas.h"
+#include "Sburb.h"
+#include "BatchHandler.h"
 #include <vector>
 #include <unordered_map>
+#include <algorithm>
+
+constexpr size_t DEFAULT_MEMORY_BUDGET = 512 * 1024 * 1024;
 
 namespace SBURB
 {
     static std::unordered_map<std::string, std::shared_ptr<AssetGraphic>> graphics;
+    static std::vector<std::shared_ptr<AssetGraphic>> graphicHandles;
     static std::unordered_map<std::string, std::shared_ptr<AssetAudio>> audio;
     static std::unordered_map<std::string, std::shared_ptr<AssetFont>> fonts;
     static std::unordered_map<std::string, std::shared_ptr<AssetPath>> paths;
     static std::unordered_map<std::string, std::shared_ptr<AssetMovie>> movies;
     static std::unordered_map<std::string, std::shared_ptr<AssetText>> text;
 
-    void AssetManager::LoadAsset(std::shared_ptr<Asset> asset)
+    static size_t memoryBudget = DEFAULT_MEMORY_BUDGET;
+    static std::vector<std::shared_ptr<Asset>> pinned;
+
+    static void UnpinAll()
+    {
+        for (auto &asset : pinned)
+        {
+            asset->Unpin();
+        }
+
+        pinned.clear();
+    }
+
+    bool AssetManager::LoadAsset(std::shared_ptr<Asset> asset)
     {
+        if (!asset)
+            return false;
+
         if (asset->GetType() == "graphic")
         {
-            graphics.insert(std::pair(asset->GetName(), std::static_pointer_cast<AssetGraphic>(asset)));
+            auto graphic = std::static_pointer_cast<AssetGraphic>(asset);
+            if (!graphics.insert(std::pair(asset->GetName(), graphic)).second)
+                return false;
+
+            graphic->SetHandle(graphicHandles.size());
+            graphicHandles.push_back(graphic);
+            return true;
+        }
+        else if (asset->GetType() == "font")
+        {
+            return fonts.insert(std::pair(asset->GetName(), std::static_pointer_cast<AssetFont>(asset))).second;
+        }
+        else if (asset->GetType() == "audio")
+        {
+            return audio.insert(std::pair(asset->GetName(), std::static_pointer_cast<AssetAudio>(asset))).second;
+        }
+        else if (asset->GetType() == "path")
+        {
+            return paths.insert(std::pair(asset->GetName(), std::static_pointer_cast<AssetPath>(asset))).second;
+        }
+        else if (asset->GetType() == "movie")
+        {
+            return movies.insert(std::pair(asset->GetName(), std::static_pointer_cast<AssetMovie>(asset))).second;
+        }
+        else if (asset->GetType() == "text")
+        {
+            return text.insert(std::pair(asset->GetName(), std::static_pointer_cast<AssetText>(asset))).second;
+        }
+
+        return false;
+    }
+
+    void AssetManager::OnAssetLoaded(std::shared_ptr<Asset> asset)
+    {
+        // The atlas needs the real size, so graphics only join it once decoded
+        // Walkable maps have no texture to pack
+        if (asset->GetType() == "graphic" && !Sburb::GetInstance()->IsHeadless() && !std::static_pointer_cast<AssetGraphic>(asset)->IsWalkable())
+            TextureAtlas::Register(std::static_pointer_cast<AssetGraphic>(asset));
+    }
+
+    bool AssetManager::CheckIsLoaded(const std::string &name)
+    {
+        // The getters below create empty entries for unknown names, so only count real ones
+        auto has = [&name](const auto &assets) {
+            auto asset = assets.find(name);
+            return asset != assets.end() && asset->second != nullptr;
+        };
+
+        return has(graphics) || has(audio) || has(fonts) || has(paths) || has(movies) || has(text);
+    }
+
+    // Residency
+    void AssetManager::SetMemoryBudget(size_t bytes)
+    {
+        memoryBudget = bytes;
+    }
+
+    size_t AssetManager::GetMemoryBudget()
+    {
+        return memoryBudget;
+    }
+
+    size_t AssetManager::GetResidentSize()
+    {
+        size_t total = TextureAtlas::GetResidentSize();
+
+        for (auto &graphic : graphicHandles)
+        {
+            total += graphic->GetResidentSize();
         }
-        else if(asset->GetType() == "font")
+
+        for (auto &asset : audio)
+        {
+            if (asset.second)
+                total += asset.second->GetResidentSize();
+        }
+
+        return total;
+    }
+
+    void AssetManager::PinAssets(const std::vector<std::shared_ptr<Asset>> &assets)
+    {
+        // Pin the new set first so assets in both never drop to zero in between
+        for (auto &asset : assets)
+        {
+            if (asset)
+                asset->Pin();
+        }
+
+        UnpinAll();
+
+        for (auto &asset : assets)
+        {
+            if (asset)
+                pinned.push_back(asset);
+        }
+    }
+
+    void AssetManager::EnforceBudget()
+    {
+        if (memoryBudget == 0)
+            return;
+
+        std::vector<std::shared_ptr<Asset>> candidates;
+        size_t total = TextureAtlas::GetResidentSize();
+
+        auto consider = [&](std::shared_ptr<Asset> asset) {
+            size_t size = asset->GetResidentSize();
+            total += size;
+
+            if (size > 0 && !asset->IsPinned())
+                candidates.push_back(asset);
+        };
+
+        for (auto &graphic : graphicHandles)
         {
-            fonts.insert(std::pair(asset->GetName(), std::static_pointer_cast<AssetFont>(asset)));
+            consider(graphic);
         }
+
+        for (auto &asset : audio)
+        {
+            if (asset.second)
+                consider(asset.second);
+        }
+
+        if (total <= memoryBudget)
+            return;
+
+        std::sort(candidates.begin(), candidates.end(), [](const std::shared_ptr<Asset> &a, const std::shared_ptr<Asset> &b)
+                  { return a->GetLastUsed() < b->GetLastUsed(); });
+
+        int evicted = 0;
+        size_t before = total;
+
+        for (auto &asset : candidates)
+        {
+            if (total <= memoryBudget)
+                break;
+
+            size_t size = asset->GetResidentSize();
+            if (asset->Evict())
+            {
+                total -= size;
+                evicted++;
+            }
+        }
+
+        // Recorded static batches keep raw texture pointers, make them record again
+        if (evicted > 0)
+            BatchHandler::getInstance().InvalidateAllStatic();
+
+        GlobalLogger->Log(Logger::Info, "Evicted " + std::to_string(evicted) + " assets, " + std::to_string((before - total) / 1024) + " KB freed.");
     }
 
     // Path
@@ -45,6 +214,23 @@ namespace SBURB
         return graphics[name];
     }
 
+    int AssetManager::GetGraphicHandle(const std::string &name)
+    {
+        auto graphic = graphics.find(name);
+        if (graphic == graphics.end() || !graphic->second)
+            return -1;
+
+        return graphic->second->GetHandle();
+    }
+
+    std::shared_ptr<AssetGraphic> AssetManager::GetGraphicByHandle(int handle)
+    {
+        if (handle < 0 || handle >= (int)graphicHandles.size())
+            return nullptr;
+
+        return graphicHandles[handle];
+    }
+
     void AssetManager::ClearGraphics()
     {
         for (auto graphic : graphics)
@@ -53,6 +239,9 @@ namespace SBURB
         }
 
         graphics.clear();
+        graphicHandles.clear();
+        UnpinAll();
+        TextureAtlas::Clear();
     }
 
     // Audio
@@ -69,6 +258,7 @@ namespace SBURB
         }
 
         audio.clear();
+        UnpinAll();
     }
 
     // Font
@@ -1,5 +1,7 @@
 #include "AssetPath.h"
 
+#include <algorithm>
+
 namespace SBURB {
 	AssetPath::AssetPath(std::string name, std::vector<Vector2> points) {
 		this->type = "path";
@@ -11,15 +13,42 @@ namespace SBURB {
 		this->points.push_back(point);
 	}
 
-	void AssetPath::QueryBatchPos(std::map<std::string, Vector2> queries, std::map<std::string, bool>* results) {
-		for (auto query : queries) {
-			(*results)[query.first] = this->Query(query.second);
+	void AssetPath::QueryBatch(const BoundaryQuery& query, bool* inside) {
+		for (int k = 0; k < query.count; k++) {
+			inside[k] = false;
+		}
+
+		// Edges on the outside, points on the inside. Same rule as Query, written without branches
+		// so the inner loop over the points can be vectorised.
+		for (int i = -1, l = this->points.size(), j = l - 1; ++i < l; j = i) {
+			const Vector2& pointA = this->points[i];
+			const Vector2& pointB = this->points[j];
+			int rise = pointB.y - pointA.y;
+			int safeRise = rise != 0 ? rise : 1;
+
+			for (int k = 0; k < query.count; k++) {
+				bool spans = (pointA.y <= query.y[k]) != (pointB.y <= query.y[k]);
+				int crossing = (pointB.x - pointA.x) * (query.y[k] - pointA.y) / safeRise + pointA.x;
+				inside[k] ^= spans & (query.x[k] < crossing);
+			}
 		}
 	}
 
-	void AssetPath::QueryBatchNeg(std::map<std::string, Vector2> queries, std::map<std::string, bool>* results) {
-		for (auto query : queries) {
-			(*results)[query.first] = !this->Query(query.second);
+	void AssetPath::QueryBatchPos(BoundaryQuery& query) {
+		bool inside[BoundaryQuery::MAX_POINTS];
+		this->QueryBatch(query, inside);
+
+		for (int k = 0; k < query.count; k++) {
+			query.results[k] = query.results[k] || inside[k];
+		}
+	}
+
+	void AssetPath::QueryBatchNeg(BoundaryQuery& query) {
+		bool inside[BoundaryQuery::MAX_POINTS];
+		this->QueryBatch(query, inside);
+
+		for (int k = 0; k < query.count; k++) {
+			query.results[k] = query.results[k] && !inside[k];
 		}
 	}
 
@@ -39,4 +68,81 @@ namespace SBURB {
 
 		return isOnPath;
     }
-}
\ No newline at end of file
+
+	void AssetPath::RasterizeInterior(BitMask& mask, int scale) {
+		std::vector<int> crossings;
+
+		for (int row = 0; row < mask.GetHeight(); row++) {
+			int y = row * scale + scale / 2;
+
+			// Same crossing rule and integer maths as Query, so the centre of each cell agrees with it
+			crossings.clear();
+			for (int i = -1, l = this->points.size(), j = l - 1; ++i < l; j = i) {
+				Vector2 pointA = this->points[i];
+				Vector2 pointB = this->points[j];
+
+				if ((pointA.y <= y && y < pointB.y) || (pointB.y <= y && y < pointA.y)) {
+					crossings.push_back((pointB.x - pointA.x) * (y - pointA.y) / (pointB.y - pointA.y) + pointA.x);
+				}
+			}
+
+			if (crossings.empty()) {
+				continue;
+			}
+
+			std::sort(crossings.begin(), crossings.end());
+
+			// A point is inside when an odd number of crossings lie to its right
+			size_t passed = 0;
+			for (int col = std::max(0, crossings.front() / scale - 1); col < mask.GetWidth(); col++) {
+				int x = col * scale + scale / 2;
+
+				while (passed < crossings.size() && crossings[passed] <= x) {
+					passed++;
+				}
+
+				if (passed == crossings.size()) {
+					break;
+				}
+
+				if ((crossings.size() - passed) % 2 == 1) {
+					mask.Set(col, row, true);
+				}
+			}
+		}
+	}
+
+	void AssetPath::RasterizeEdges(BitMask& mask, int scale) {
+		for (int i = -1, l = this->points.size(), j = l - 1; ++i < l; j = i) {
+			Vector2 pointA = this->points[i];
+			Vector2 pointB = this->points[j];
+
+			int minY = std::min(pointA.y, pointB.y);
+			int maxY = std::max(pointA.y, pointB.y);
+			int firstRow = (int)std::floor((float)minY / scale);
+			int lastRow = (int)std::floor((float)maxY / scale);
+
+			for (int row = firstRow; row <= lastRow; row++) {
+				// Part of the segment inside this row of cells
+				float fromY = std::max<float>(minY, row * scale);
+				float toY = std::min<float>(maxY, (row + 1) * scale);
+				float fromX = pointA.x;
+				float toX = pointB.x;
+
+				if (pointA.y != pointB.y) {
+					float slope = (float)(pointB.x - pointA.x) / (pointB.y - pointA.y);
+					fromX = pointA.x + (fromY - pointA.y) * slope;
+					toX = pointA.x + (toY - pointA.y) * slope;
+				}
+
+				int firstCol = (int)std::floor(std::min(fromX, toX) / scale);
+				int lastCol = (int)std::floor(std::max(fromX, toX) / scale);
+
+				// Pad by a cell all round to absorb the rounding in Query
+				for (int padRow = row - 1; padRow <= row + 1; padRow++) {
+					mask.SetSpan(padRow, firstCol - 1, lastCol + 1);
+				}
+			}
+		}
+	}
+}
@@ -1,112 +1,224 @@
 #include "BatchHandler.h"
 #include <SFML/Graphics/RenderTarget.hpp>
 #include "AssetManager.h"
+#include "Profiler.h"
 
 #define BATCH_SIZE 512
 
 namespace SBURB
 {
     BatchHandler::BatchHandler()
-        : currentTexName(""), verticesInitialized(false),
-          offset(0), verticesSize(0), target(nullptr)
+        : currentHandle(-1), currentTexture(nullptr), offset(0), target(nullptr),
+          stream(sf::Quads, sf::VertexBuffer::Stream), streamCapacity(0), streamOffset(0),
+          culling(false), recordingOwner(nullptr), recording(nullptr)
     {
+        this->vertices.resize(BATCH_SIZE);
     }
 
     void BatchHandler::DrawPrimitive(const sf::VertexArray &coords, sf::RenderTarget &target)
     {
-        if (currentTexName != "")
+        if (currentTexture != nullptr && offset != 0)
             DrawBatch();
-        currentTexName = "";
+        currentHandle = -1;
+        currentTexture = nullptr;
 
         if (this->target == nullptr)
             this->target = &target;
 
-        if (!verticesInitialized)
-            InitializeVertices();
+        PushQuad(coords, false);
+    }
 
-        if (offset >= verticesSize)
-            GrowVertices();
+    void BatchHandler::DrawSpriteRect(int textureHandle, const sf::VertexArray &coords, sf::RenderTarget &target)
+    {
+        if (textureHandle != currentHandle)
+        {
+            auto graphic = AssetManager::GetGraphicByHandle(textureHandle);
+            if (!graphic)
+                return;
 
-        sf::Vertex *quad = &vertices[offset];
+            // Sheets packed into the same atlas page share a texture, so only flush when that changes
+            const sf::Texture *texture = graphic->GetTexture().get();
 
-        quad[0].position = coords[0].position;
-        quad[1].position = coords[1].position;
-        quad[2].position = coords[2].position;
-        quad[3].position = coords[3].position;
+            if (texture != currentTexture)
+            {
+                if (offset != 0)
+                    DrawBatch();
+                this->currentTexture = texture;
 
-        quad[0].color = coords[0].color;
-        quad[1].color = coords[1].color;
-        quad[2].color = coords[2].color;
-        quad[3].color = coords[3].color;
+                if (this->recording)
+                    this->recording->segments.push_back({texture, this->recording->vertices.size(), 0});
+            }
 
-        offset += 4;
+            this->currentHandle = textureHandle;
+        }
+
+        if (this->target == nullptr)
+            this->target = &target;
+
+        PushQuad(coords, true);
     }
 
-    void BatchHandler::DrawSpriteRect(std::string textureName, const sf::VertexArray &coords, sf::RenderTarget &target)
+    void BatchHandler::PushQuad(const sf::VertexArray &coords, bool textured)
     {
-        if (textureName != currentTexName)
+        if (this->recording)
         {
-            if (currentTexName != "")
-                DrawBatch();
-            this->currentTexName = textureName;
-        }
+            if (this->recording->segments.empty() || !textured)
+                this->recording->segments.push_back({textured ? currentTexture : nullptr, this->recording->vertices.size(), 0});
 
-        if (this->target == nullptr)
-            this->target = &target;
+            for (int i = 0; i < 4; i++)
+                this->recording->vertices.push_back(coords[i]);
 
-        if (!verticesInitialized)
-            InitializeVertices();
+            this->recording->segments.back().count += 4;
+            return;
+        }
 
-        if (offset >= verticesSize)
-            GrowVertices();
+        // Grow only, the staging array is reused every flush
+        if (offset + 4 > vertices.size())
+            vertices.resize(vertices.size() + BATCH_SIZE);
 
         sf::Vertex *quad = &vertices[offset];
 
-        quad[0].position = coords[0].position;
-        quad[1].position = coords[1].position;
-        quad[2].position = coords[2].position;
-        quad[3].position = coords[3].position;
+        for (int i = 0; i < 4; i++)
+        {
+            quad[i].position = coords[i].position;
+            quad[i].color = coords[i].color;
+            if (textured)
+                quad[i].texCoords = coords[i].texCoords;
+        }
+
+        offset += 4;
+    }
 
-        quad[0].texCoords = coords[0].texCoords;
-        quad[1].texCoords = coords[1].texCoords;
-        quad[2].texCoords = coords[2].texCoords;
-        quad[3].texCoords = coords[3].texCoords;
+    void BatchHandler::ReserveStream(size_t count)
+    {
+        if (count <= this->streamCapacity)
+            return;
 
-        quad[0].color = coords[0].color;
-        quad[1].color = coords[1].color;
-        quad[2].color = coords[2].color;
-        quad[3].color = coords[3].color;
+        size_t capacity = std::max(this->streamCapacity * 2, (size_t)BATCH_SIZE * 4);
+        while (capacity < count)
+            capacity *= 2;
 
-        offset += 4;
+        if (this->stream.create(capacity))
+        {
+            this->streamCapacity = capacity;
+            this->streamOffset = 0;
+        }
     }
 
     void BatchHandler::DrawBatch()
     {
+        if (offset == 0 || target == nullptr)
+        {
+            offset = 0;
+            target = nullptr;
+            return;
+        }
+
+        SBURB_PROFILE_SCOPE("DrawBatch");
+        SBURB_PROFILE_COUNT(DrawCalls, 1);
+        SBURB_PROFILE_COUNT(Vertices, offset);
+
         sf::RenderStates states = sf::RenderStates();
-        if (currentTexName != "")
-            states.texture = AssetManager::GetGraphicByName(currentTexName)->GetAsset().get();
-        if (offset != verticesSize)
-            vertices.resize(offset);
-        target->draw(vertices, states);
-        verticesInitialized = false;
+        states.texture = currentTexture;
+
+        if (sf::VertexBuffer::isAvailable())
+        {
+            ReserveStream(offset);
+
+            // Batches append, so nothing drawn earlier gets written over. Once full the buffer is created again,
+            // which orphans the old storage: the GPU keeps reading that while we fill fresh memory from the start.
+            if (this->streamOffset + offset > this->streamCapacity)
+            {
+                this->stream.create(this->streamCapacity);
+                this->streamOffset = 0;
+            }
+
+            this->stream.update(vertices.data(), offset, this->streamOffset);
+            target->draw(this->stream, this->streamOffset, offset, states);
+            this->streamOffset += offset;
+        }
+        else
+        {
+            target->draw(vertices.data(), offset, sf::Quads, states);
+        }
+
         offset = 0;
-        verticesSize = 0;
-        vertices.clear();
         target = nullptr;
     }
 
-    void BatchHandler::InitializeVertices()
+    bool BatchHandler::DrawStatic(const void *owner, sf::RenderTarget &target)
     {
-        vertices.setPrimitiveType(sf::Quads);
-        vertices.resize(BATCH_SIZE);
-        verticesSize = BATCH_SIZE;
-        offset = 0;
-        verticesInitialized = true;
+        auto batch = this->staticBatches.find(owner);
+        if (batch == this->staticBatches.end())
+            return false;
+
+        // Keep ordering with whatever was queued before us
+        if (offset != 0)
+            DrawBatch();
+
+        for (auto &segment : batch->second.segments)
+        {
+            SBURB_PROFILE_COUNT(DrawCalls, 1);
+            SBURB_PROFILE_COUNT(Vertices, segment.count);
+
+            sf::RenderStates states = sf::RenderStates();
+            states.texture = segment.texture;
+
+            if (sf::VertexBuffer::isAvailable())
+                target.draw(batch->second.buffer, segment.first, segment.count, states);
+            else
+                target.draw(batch->second.vertices.data() + segment.first, segment.count, sf::Quads, states);
+        }
+
+        // Whatever comes next has to rebind its texture
+        Reset();
+        return true;
+    }
+
+    void BatchHandler::BeginStatic(const void *owner)
+    {
+        if (offset != 0)
+            DrawBatch();
+        Reset();
+
+        StaticBatch &batch = this->staticBatches[owner];
+        batch.vertices.clear();
+        batch.segments.clear();
+
+        this->recordingOwner = owner;
+        this->recording = &batch;
+    }
+
+    void BatchHandler::EndStatic(sf::RenderTarget &target)
+    {
+        if (!this->recording)
+            return;
+
+        StaticBatch &batch = *this->recording;
+        this->recording = nullptr;
+        const void *owner = this->recordingOwner;
+        this->recordingOwner = nullptr;
+        Reset();
+
+        if (sf::VertexBuffer::isAvailable() && !batch.vertices.empty())
+        {
+            batch.buffer.setPrimitiveType(sf::Quads);
+            batch.buffer.setUsage(sf::VertexBuffer::Static);
+            if (batch.buffer.create(batch.vertices.size()))
+                batch.buffer.update(batch.vertices.data());
+        }
+
+        DrawStatic(owner, target);
+    }
+
+    void BatchHandler::InvalidateStatic(const void *owner)
+    {
+        this->staticBatches.erase(owner);
     }
 
-    void BatchHandler::GrowVertices()
+    void BatchHandler::InvalidateAllStatic()
     {
-        verticesSize += BATCH_SIZE;
-        vertices.resize(verticesSize);
+        this->staticBatches.clear();
+        Reset();
     }
-}
\ No newline at end of file
+}
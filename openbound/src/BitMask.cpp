@@ -0,0 +1,51 @@
+#include "BitMask.h"
+
+#include <algorithm>
+
+namespace SBURB
+{
+    BitMask::BitMask()
+        : width(0), height(0)
+    {
+    }
+
+    BitMask::BitMask(int width, int height)
+        : width(0), height(0)
+    {
+        this->Resize(width, height);
+    }
+
+    void BitMask::Resize(int width, int height)
+    {
+        this->width = std::max(width, 0);
+        this->height = std::max(height, 0);
+        this->bits.assign(((size_t)this->width * this->height + 63) / 64, 0);
+    }
+
+    void BitMask::Fill(bool value)
+    {
+        std::fill(this->bits.begin(), this->bits.end(), value ? ~(uint64_t)0 : 0);
+    }
+
+    void BitMask::Release()
+    {
+        this->width = 0;
+        this->height = 0;
+        this->bits.clear();
+        this->bits.shrink_to_fit();
+    }
+
+    void BitMask::SetSpan(int y, int fromX, int toX)
+    {
+        if (y < 0 || y >= this->height)
+            return;
+
+        fromX = std::max(fromX, 0);
+        toX = std::min(toX, this->width - 1);
+
+        for (int x = fromX; x <= toX; x++)
+        {
+            this->Set(x, y, true);
+        }
+    }
+}
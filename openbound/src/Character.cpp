@@ -121,8 +121,8 @@ namespace SBURB {
 
 			if (this->followBuffer.size() <= FOLLOW_BUFFER_LENGTH && !this->following->IsNPC()) {
 				if (didMove) {
-					this->x = destPos.x;
-					this->y = destPos.y;
+					this->SetX(destPos.x);
+					this->SetY(destPos.y);
 				}
 
 				this->MoveNone();
@@ -434,47 +434,46 @@ namespace SBURB {
 		return queries;
 	}
 
-	std::string Character::Serialize(std::string output) {
-		output = output + "\n<character name='" + this->name +
-			"' x='" + std::to_string(this->x) +
-			"' y='" + std::to_string(this->y) +
-			"' width='" + std::to_string(this->width) +
-			"' height='" + std::to_string(this->height) +
-			"' state='" + this->state +
-			"' facing='" + this->facing;
+	void Character::Serialize(SerialWriter &out) {
+		out << "\n<character name='" << this->name <<
+			"' x='" << this->x <<
+			"' y='" << this->y <<
+			"' width='" << this->width <<
+			"' height='" << this->height <<
+			"' state='" << this->state <<
+			"' facing='" << this->facing;
 
 		if (!this->bootstrap) {
-			output = output + "' sx='" + std::to_string(this->animations["walkFront"]->GetX()) +
-				"' sy='" + std::to_string(this->animations["walkFront"]->GetY()) +
-				"' sWidth='" + std::to_string(this->animations["walkFront"]->GetColSize()) +
-				"' sHeight='" + std::to_string(this->animations["walkFront"]->GetRowSize()) +
-				"' sheet='" + this->animations["walkFront"]->GetSheet()->GetName();
+			auto walkFront = this->animations["walkFront"];
+			out << "' sx='" << walkFront->GetX() <<
+				"' sy='" << walkFront->GetY() <<
+				"' sWidth='" << walkFront->GetColSize() <<
+				"' sHeight='" << walkFront->GetRowSize() <<
+				"' sheet='" << walkFront->GetSheet()->GetName();
 		}
 		else {
-			output = output + "' bootstrap='true";
+			out << "' bootstrap='true";
 		}
 		if (this->following) {
-			output = output + "' following='" + this->following->GetName() + "";
+			out << "' following='" << this->following->GetName();
 		}
 		if (this->follower) {
-			output = output + "' follower='" + this->follower->GetName() + "";
+			out << "' follower='" << this->follower->GetName();
 		}
 
-		output = output + "'>";
+		out << "'>";
 
-		for (auto anim : this->animations) {
+		for (const auto &anim : this->animations) {
 			if (this->bootstrap || (anim.second->GetName().find("idle") == std::string::npos && anim.second->GetName().find("walk") == std::string::npos)) {
-				output = anim.second->Serialize(output);
+				anim.second->Serialize(out);
 			}
 		}
 
-		for (auto action : this->actions) {
-			output = action->Serialize(output);
+		for (const auto &action : this->actions) {
+			action->Serialize(out);
 		}
 
-		output = output + "\n</character>";
-
-		return output;
+		out << "\n</character>";
 	}
 
 	bool Character::IsNPC() {
@@ -3,6 +3,12 @@
 #include "Parser.h"
 #include "AssetManager.h"
 #include "Serializer.h"
+#include "SaveStore.h"
+
+#include <deque>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 
 #if defined(_WIN32) || defined(WIN32)
 #include <windows.h>
@@ -13,175 +19,195 @@
 
 namespace SBURB
 {
+    template <auto Handler>
+    static std::shared_ptr<Trigger> Invoke(const ActionArgs &args, std::shared_ptr<ActionQueue> queue)
+    {
+        if constexpr (std::is_invocable_v<decltype(Handler)>)
+        {
+            Handler();
+            return nullptr;
+        }
+        else if constexpr (std::is_void_v<std::invoke_result_t<decltype(Handler), const ActionArgs &>>)
+        {
+            Handler(args);
+            return nullptr;
+        }
+        else
+        {
+            return Handler(args);
+        }
+    }
+
+    // Indexed by command id, an empty slot is a name that was asked for but never registered.
+    // A deque so a command registering others while it runs isn't moved out from under itself.
+    static std::deque<CommandHandler::Command> commands;
+    static std::unordered_map<std::string, CommandHandler::CommandId> commandIds;
+    // Builtins that only move sprites between rooms and change what autosaves copy anyway. Anything
+    // else may rearrange the state, the next autosave then serializes all of it.
+    static std::unordered_set<CommandHandler::CommandId> playCommandIds;
+
+    static void RegisterBuiltins()
+    {
+        static bool registered = false;
+        if (registered)
+            return;
+        registered = true;
+
+        const std::pair<const char *, CommandHandler::Command> builtins[] = {
+            {"talk", Invoke<&CommandHandler::Talk>},
+            {"randomTalk", Invoke<&CommandHandler::RandomTalk>},
+            {"changeRoom", Invoke<&CommandHandler::ChangeRoom>},
+            {"changeFocus", Invoke<&CommandHandler::ChangeFocus>},
+            {"teleport", Invoke<&CommandHandler::Teleport>},
+            {"changeChar", Invoke<&CommandHandler::ChangeChar>},
+            {"playSong", Invoke<&CommandHandler::PlaySong>},
+            {"becomeNPC", Invoke<&CommandHandler::BecomeNPC>},
+            {"becomePlayer", Invoke<&CommandHandler::BecomePlayer>},
+            {"playSound", Invoke<&CommandHandler::PlaySound>},
+            {"playEffect", Invoke<&CommandHandler::PlayEffect>},
+            {"playAnimation", Invoke<&CommandHandler::PlayAnimation>},
+            {"startAnimation", Invoke<&CommandHandler::StartAnimation>},
+            // Misspelt in earlier versions, kept so old saves still work
+            {"starAnimation", Invoke<&CommandHandler::StartAnimation>},
+            {"addAction", Invoke<&CommandHandler::AddAction>},
+            {"addActions", Invoke<&CommandHandler::AddActions>},
+            {"removeAction", Invoke<&CommandHandler::RemoveAction>},
+            {"removeActions", Invoke<&CommandHandler::RemoveActions>},
+            {"presentAction", Invoke<&CommandHandler::PresentAction>},
+            {"presentActions", Invoke<&CommandHandler::PresentActions>},
+            {"openChest", Invoke<&CommandHandler::OpenChest>},
+            {"deltaSprite", Invoke<&CommandHandler::DeltaSprite>},
+            {"moveSprite", Invoke<&CommandHandler::MoveSprite>},
+            {"depthSprite", Invoke<&CommandHandler::DepthSprite>},
+            {"playMovie", Invoke<&CommandHandler::PlayMovie>},
+            {"removeMovie", Invoke<&CommandHandler::RemoveMovie>},
+            {"disableControl", Invoke<&CommandHandler::DisableControl>},
+            {"enableControl", Invoke<&CommandHandler::EnableControl>},
+            {"waitFor", Invoke<&CommandHandler::WaitFor>},
+            {"macro", Invoke<&CommandHandler::Macro>},
+            {"sleep", Invoke<&CommandHandler::Sleep>},
+            {"pauseActionQueue", Invoke<&CommandHandler::PauseActionQueue>},
+            {"pauseActionQueues", Invoke<&CommandHandler::PauseActionQueues>},
+            {"resumeActionQueue", Invoke<&CommandHandler::ResumeActionQueue>},
+            {"resumeActionQueues", Invoke<&CommandHandler::ResumeActionQueues>},
+            {"cancelActionQueue", Invoke<&CommandHandler::CancelActionQueue>},
+            {"cancelActionQueues", Invoke<&CommandHandler::CancelActionQueues>},
+            {"pauseActionQueueGroup", Invoke<&CommandHandler::PauseActionQueueGroup>},
+            {"pauseActionQueueGroups", Invoke<&CommandHandler::PauseActionQueueGroups>},
+            {"resumeActionQueueGroup", Invoke<&CommandHandler::ResumeActionQueueGroup>},
+            {"resumeActionQueueGroups", Invoke<&CommandHandler::ResumeActionQueueGroups>},
+            {"cancelActionQueueGroup", Invoke<&CommandHandler::CancelActionQueueGroup>},
+            {"cancelActionQueueGroups", Invoke<&CommandHandler::CancelActionQueueGroups>},
+            {"addSprite", Invoke<&CommandHandler::AddSprite>},
+            {"removeSprite", Invoke<&CommandHandler::RemoveSprite>},
+            {"cloneSprite", Invoke<&CommandHandler::CloneSprite>},
+            {"addWalkable", Invoke<&CommandHandler::AddWalkable>},
+            {"addUnwalkable", Invoke<&CommandHandler::AddUnwalkable>},
+            {"addMotionPath", Invoke<&CommandHandler::AddMotionPath>},
+            {"removeWalkable", Invoke<&CommandHandler::RemoveWalkable>},
+            {"removeUnwalkable", Invoke<&CommandHandler::RemoveUnwalkable>},
+            {"toggleVolume", Invoke<&CommandHandler::ToggleVolume>},
+            {"changeMode", Invoke<&CommandHandler::ChangeMode>},
+            {"loadStateFile", Invoke<&CommandHandler::LoadStateFile>},
+            {"fadeOut", Invoke<&CommandHandler::FadeOut>},
+            {"changeRoomRemote", Invoke<&CommandHandler::ChangeRoomRemote>},
+            {"teleportRemote", Invoke<&CommandHandler::TeleportRemote>},
+            {"setButtonState", Invoke<&CommandHandler::SetButtonState>},
+            {"skipDialog", Invoke<&CommandHandler::SkipDialog>},
+            {"follow", Invoke<&CommandHandler::Follow>},
+            {"unfollow", Invoke<&CommandHandler::Unfollow>},
+            {"addOverlay", Invoke<&CommandHandler::AddOverlay>},
+            {"removeOverlay", Invoke<&CommandHandler::RemoveOverlay>},
+            {"save", Invoke<&CommandHandler::Save>},
+            {"load", Invoke<&CommandHandler::Load>},
+            {"saveOrLoad", Invoke<&CommandHandler::SaveOrLoad>},
+            {"setgameState", Invoke<&CommandHandler::SetGameState>},
+            {"goBack", Invoke<&CommandHandler::GoBack>},
+            {"try", Invoke<&CommandHandler::Try>},
+            {"walk", Invoke<&CommandHandler::Walk>},
+            {"openLink", Invoke<&CommandHandler::OpenLink>},
+            {"openDirect", Invoke<&CommandHandler::OpenDirect>},
+            {"cancel", Invoke<&CommandHandler::Cancel>},
+        };
+
+        for (auto &builtin : builtins)
+        {
+            CommandHandler::RegisterCommand(builtin.first, builtin.second);
+        }
+
+        const char *playCommands[] = {
+            "talk", "randomTalk", "changeRoom", "changeFocus", "teleport", "changeChar", "playSong", "playSound",
+            "playEffect", "playAnimation", "startAnimation", "starAnimation", "deltaSprite", "moveSprite", "playMovie",
+            "removeMovie", "disableControl", "enableControl", "waitFor", "macro", "sleep", "pauseActionQueue",
+            "pauseActionQueues", "resumeActionQueue", "resumeActionQueues", "cancelActionQueue", "cancelActionQueues",
+            "pauseActionQueueGroup", "pauseActionQueueGroups", "resumeActionQueueGroup", "resumeActionQueueGroups",
+            "cancelActionQueueGroup", "cancelActionQueueGroups", "addSprite", "removeSprite", "toggleVolume",
+            "changeMode", "fadeOut", "changeRoomRemote", "teleportRemote", "skipDialog", "save", "load", "saveOrLoad",
+            "setgameState", "goBack", "try", "walk", "openLink", "openDirect", "cancel",
+        };
+
+        for (const char *name : playCommands)
+        {
+            playCommandIds.insert(commandIds[name]);
+        }
+    }
+
+    CommandHandler::CommandId CommandHandler::GetCommandId(const std::string &name)
+    {
+        RegisterBuiltins();
+
+        std::string key = trim(name);
+        auto found = commandIds.find(key);
+        if (found != commandIds.end())
+            return found->second;
+
+        CommandId id = commands.size();
+        commands.emplace_back();
+        commandIds[key] = id;
+        return id;
+    }
+
+    void CommandHandler::RegisterCommand(const std::string &name, Command command)
+    {
+        CommandId id = GetCommandId(name);
+        commands[id] = command;
+        // Nothing is known about what a replacement does
+        playCommandIds.erase(id);
+    }
+
+    bool CommandHandler::HasCommand(const std::string &name)
+    {
+        RegisterBuiltins();
+
+        auto found = commandIds.find(trim(name));
+        return found != commandIds.end() && commands[found->second];
+    }
+
     std::shared_ptr<Trigger> CommandHandler::PerformActionSilent(std::shared_ptr<Action> action, std::shared_ptr<ActionQueue> queue)
     {
         action->SetTimes(action->GetTimes() - 1);
 
-        std::string info = action->info;
-        if (info != "")
-        {
-            info = trim(info);
-        }
-
-        std::string command = trim(action->GetCommand());
-
-        if (command == "talk")
-            CommandHandler::Talk(info);
-        else if (command == "randomTalk")
-            CommandHandler::RandomTalk(info);
-        else if (command == "changeRoom")
-            CommandHandler::ChangeRoom(info);
-        else if (command == "changeFocus")
-            CommandHandler::ChangeFocus(info);
-        else if (command == "teleport")
-            CommandHandler::Teleport(info);
-        else if (command == "changeChar")
-            CommandHandler::ChangeChar(info);
-        else if (command == "playSong")
-            CommandHandler::PlaySong(info);
-        else if (command == "becomeNPC")
-            CommandHandler::BecomeNPC(info);
-        else if (command == "becomePlayer")
-            CommandHandler::BecomePlayer(info);
-        else if (command == "playSound")
-            CommandHandler::PlaySound(info);
-        else if (command == "playEffect")
-            CommandHandler::PlayEffect(info);
-        else if (command == "playAnimation")
-            CommandHandler::PlayAnimation(info);
-        else if (command == "starAnimation")
-            CommandHandler::StartAnimation(info);
-        else if (command == "addAction")
-            CommandHandler::AddAction(info);
-        else if (command == "addActions")
-            CommandHandler::AddActions(info);
-        else if (command == "removeAction")
-            CommandHandler::RemoveAction(info);
-        else if (command == "removeActions")
-            CommandHandler::RemoveActions(info);
-        else if (command == "presentAction")
-            CommandHandler::PresentAction(info);
-        else if (command == "presentActions")
-            CommandHandler::PresentActions(info);
-        else if (command == "openChest")
-            CommandHandler::OpenChest(info);
-        else if (command == "deltaSprite")
-            CommandHandler::DeltaSprite(info);
-        else if (command == "moveSprite")
-            CommandHandler::MoveSprite(info);
-        else if (command == "depthSprite")
-            CommandHandler::DepthSprite(info);
-        else if (command == "playMovie")
-            CommandHandler::PlayMovie(info);
-        else if (command == "removeMovie")
-            CommandHandler::RemoveMovie(info);
-        else if (command == "disableControl")
-            CommandHandler::DisableControl(info);
-        else if (command == "enableControl")
-            CommandHandler::EnableControl(info);
-        else if (command == "waitFor")
-            return CommandHandler::WaitFor(info);
-        else if (command == "macro")
-            return CommandHandler::Macro(info);
-        else if (command == "sleep")
-            return CommandHandler::Sleep(info);
-        else if (command == "pauseActionQueue")
-            CommandHandler::PauseActionQueue(info);
-        else if (command == "pauseActionQueues")
-            CommandHandler::PauseActionQueues(info);
-        else if (command == "resumeActionQueue")
-            CommandHandler::ResumeActionQueue(info);
-        else if (command == "resumeActionQueues")
-            CommandHandler::ResumeActionQueues(info);
-        else if (command == "cancelActionQueue")
-            CommandHandler::CancelActionQueue(info);
-        else if (command == "cancelActionQueues")
-            CommandHandler::CancelActionQueues(info);
-        else if (command == "pauseActionQueueGroup")
-            CommandHandler::PauseActionQueueGroup(info);
-        else if (command == "pauseActionQueueGroups")
-            CommandHandler::PauseActionQueueGroups(info);
-        else if (command == "resumeActionQueueGroup")
-            CommandHandler::ResumeActionQueueGroup(info);
-        else if (command == "resumeActionQueueGroups")
-            CommandHandler::ResumeActionQueueGroups(info);
-        else if (command == "cancelActionQueueGroup")
-            CommandHandler::CancelActionQueueGroup(info);
-        else if (command == "cancelActionQueueGroups")
-            CommandHandler::CancelActionQueueGroups(info);
-        else if (command == "addSprite")
-            CommandHandler::AddSprite(info);
-        else if (command == "removeSprite")
-            CommandHandler::RemoveSprite(info);
-        else if (command == "cloneSprite")
-            CommandHandler::CloneSprite(info);
-        else if (command == "addWalkable")
-            CommandHandler::AddWalkable(info);
-        else if (command == "addUnwalkable")
-            CommandHandler::AddUnwalkable(info);
-        else if (command == "addMotionPath")
-            CommandHandler::AddMotionPath(info);
-        else if (command == "removeWalkable")
-            CommandHandler::RemoveWalkable(info);
-        else if (command == "removeUnwalkable")
-            CommandHandler::RemoveUnwalkable(info);
-        else if (command == "toggleVolume")
-            CommandHandler::ToggleVolume();
-        else if (command == "changeMode")
-            CommandHandler::ChangeMode(info);
-        else if (command == "loadStateFile")
-            CommandHandler::LoadStateFile(info);
-        else if (command == "fadeOut")
-            CommandHandler::FadeOut();
-        else if (command == "changeRoomRemote")
-            CommandHandler::ChangeRoomRemote(info);
-        else if (command == "teleportRemote")
-            CommandHandler::TeleportRemote(info);
-        else if (command == "setButtonState")
-            CommandHandler::SetButtonState(info);
-        else if (command == "skipDialog")
-            CommandHandler::SkipDialog();
-        else if (command == "follow")
-            CommandHandler::Follow(info);
-        else if (command == "unfollow")
-            CommandHandler::Unfollow(info);
-        else if (command == "addOverlay")
-            CommandHandler::AddOverlay(info);
-        else if (command == "removeOverlay")
-            CommandHandler::RemoveOverlay(info);
-        else if (command == "save")
-            CommandHandler::Save(info);
-        else if (command == "load")
-            CommandHandler::Load(info);
-        else if (command == "saveOrLoad")
-            CommandHandler::SaveOrLoad(info);
-        else if (command == "setgameState")
-            CommandHandler::SetGameState(info);
-        else if (command == "goBack")
-            CommandHandler::GoBack(info);
-        else if (command == "try")
-            CommandHandler::Try(info);
-        else if (command == "walk")
-            CommandHandler::Walk(info);
-        else if (command == "openLink")
-            CommandHandler::OpenLink(info);
-        else if (command == "openDirect")
-            CommandHandler::OpenDirect(info);
-        else if (command == "cancel")
-            CommandHandler::Cancel(info);
+        // Unknown commands do nothing, same as they always have
+        Command &command = commands[action->GetCommandId()];
+        if (command)
+        {
+            if (!playCommandIds.count(action->GetCommandId()))
+                SaveStore::InvalidateBase();
+            return command(action->GetArgs(), queue);
+        }
 
         return nullptr;
     }
 
-    void CommandHandler::Talk(std::string info)
+    void CommandHandler::Talk(const ActionArgs &args)
     {
-        Sburb::GetInstance()->GetDialoger()->StartDialog(info);
+        Sburb::GetInstance()->GetDialoger()->StartDialog(args.GetText());
     }
 
-    void CommandHandler::RandomTalk(std::string info)
+    void CommandHandler::RandomTalk(const ActionArgs &args)
     {
         auto dialoger = Sburb::GetInstance()->GetDialoger();
-        dialoger->StartDialog(info);
+        dialoger->StartDialog(args.GetText());
 
         int randomNum = floor(rand() * (dialoger->GetQueue().size() + 1));
         if (randomNum)
@@ -195,57 +221,41 @@ namespace SBURB
         }
     }
 
-    std::vector<std::string> ParseParams(std::string info)
+    void CommandHandler::ChangeRoom(const ActionArgs &args)
     {
-        std::vector<std::string> params = split(info, ",");
-
-        for (int i = 0; i < params.size(); i++)
-        {
-            params[i] = trim(params[i]);
-        }
-
-        return params;
-    }
-
-    void CommandHandler::ChangeRoom(std::string info)
-    {
-        auto params = ParseParams(info);
-        Sburb::GetInstance()->ChangeRoom(Sburb::GetInstance()->GetRoom(params[0]), stoi(params[1]), stoi(params[2]));
+        Sburb::GetInstance()->ChangeRoom(args.GetRoom(0), args.GetInt(1), args.GetInt(2));
         Sburb::GetInstance()->SetLoadingRoom(false);
     }
 
-    void CommandHandler::ChangeFocus(std::string info)
+    void CommandHandler::ChangeFocus(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        if (params[0] == "null")
+        if (args.Get(0) == "null")
         {
             Sburb::GetInstance()->SetFocus(nullptr);
             Sburb::GetInstance()->SetDestFocus(nullptr);
         }
         else
         {
-            std::shared_ptr<Sprite> sprite = Parser::ParseCharacterString(params[0]);
+            std::shared_ptr<Sprite> sprite = args.GetSprite(0);
             Sburb::GetInstance()->SetDestFocus(sprite);
         }
     }
 
-    void CommandHandler::Teleport(std::string info)
+    void CommandHandler::Teleport(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-
-        CommandHandler::ChangeRoom(info);
+        CommandHandler::ChangeRoom(args);
         Sburb::GetInstance()->PlayEffect(Sburb::GetInstance()->GetEffect("teleportEffect"), Sburb::GetInstance()->GetCharacter()->GetX(), Sburb::GetInstance()->GetCharacter()->GetY());
-        Sburb::GetInstance()->GetQueue()->GetCurrentAction()->SetFollowUp(std::make_shared<Action>("playEffect", "teleportEffect," + params[1] + "," + params[2], "", "", Sburb::GetInstance()->GetQueue()->GetCurrentAction()->GetFollowUp()));
+        Sburb::GetInstance()->GetQueue()->GetCurrentAction()->SetFollowUp(std::make_shared<Action>("playEffect", "teleportEffect," + args.Get(1) + "," + args.Get(2), "", "", Sburb::GetInstance()->GetQueue()->GetCurrentAction()->GetFollowUp()));
     }
 
-    void CommandHandler::ChangeChar(std::string info)
+    void CommandHandler::ChangeChar(const ActionArgs &args)
     {
         auto oldCharacter = Sburb::GetInstance()->GetCharacter();
         oldCharacter->BecomeNPC();
         oldCharacter->MoveNone();
         oldCharacter->Walk();
 
-        Sburb::GetInstance()->SetCharacter(std::static_pointer_cast<Character>(Sburb::GetInstance()->GetSprite(info)));
+        Sburb::GetInstance()->SetCharacter(std::static_pointer_cast<Character>(args.GetSprite(0)));
         auto newCharacter = Sburb::GetInstance()->GetCharacter();
 
         Sburb::GetInstance()->SetDestFocus(newCharacter);
@@ -253,53 +263,47 @@ namespace SBURB
         Sburb::GetInstance()->SetCurRoomOf(newCharacter);
     }
 
-    void CommandHandler::PlaySong(std::string info)
+    void CommandHandler::PlaySong(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-
-        Sburb::GetInstance()->ChangeBGM(std::make_shared<Music>(params[0], stof(params.size() == 2 ? params[1] : "0")));
+        Sburb::GetInstance()->ChangeBGM(std::make_shared<Music>(args.Get(0), args.Size() == 2 ? args.GetFloat(1) : 0));
     }
 
-    void CommandHandler::BecomeNPC(std::string info)
+    void CommandHandler::BecomeNPC(const ActionArgs &args)
     {
         Sburb::GetInstance()->GetCharacter()->BecomeNPC();
     }
 
-    void CommandHandler::BecomePlayer(std::string info)
+    void CommandHandler::BecomePlayer(const ActionArgs &args)
     {
         Sburb::GetInstance()->GetCharacter()->BecomePlayer();
     }
 
-    void CommandHandler::PlaySound(std::string info)
+    void CommandHandler::PlaySound(const ActionArgs &args)
     {
-        Sburb::GetInstance()->PlaySound(std::make_shared<Sound>(trim(info), AssetManager::GetAudioByName(trim(info))));
+        Sburb::GetInstance()->PlaySound(std::make_shared<Sound>(args.GetText(), AssetManager::GetAudioByName(args.GetText())));
     }
 
-    void CommandHandler::PlayEffect(std::string info)
+    void CommandHandler::PlayEffect(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        Sburb::GetInstance()->PlayEffect(Sburb::GetInstance()->GetEffect(params[0]), stoi(params[1]), stoi(params[2]));
+        Sburb::GetInstance()->PlayEffect(Sburb::GetInstance()->GetEffect(args.Get(0)), args.GetInt(1), args.GetInt(2));
     }
 
-    void CommandHandler::PlayAnimation(std::string info)
+    void CommandHandler::PlayAnimation(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto sprite = Parser::ParseCharacterString(params[0]);
+        auto sprite = args.GetSprite(0);
 
-        sprite->StartAnimation(params[1]);
+        sprite->StartAnimation(args.Get(1));
     }
 
-    void CommandHandler::StartAnimation(std::string info)
+    void CommandHandler::StartAnimation(const ActionArgs &args)
     {
-        CommandHandler::PlayAnimation(info);
+        CommandHandler::PlayAnimation(args);
     }
 
-    void CommandHandler::AddAction(std::string info)
+    void CommandHandler::AddAction(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        int firstComma = info.find(",");
-        auto sprite = Parser::ParseCharacterString(params[0]);
-        std::string actionString = info.substr(firstComma + 1, info.size());
+        auto sprite = args.GetSprite(0);
+        std::string actionString = args.GetFrom(1);
 
         std::vector<std::shared_ptr<Action>> actions = Parser::ParseActionString(actionString);
 
@@ -310,57 +314,53 @@ namespace SBURB
         }
     }
 
-    void CommandHandler::AddActions(std::string info)
+    void CommandHandler::AddActions(const ActionArgs &args)
     {
-        CommandHandler::AddAction(info);
+        CommandHandler::AddAction(args);
     }
 
-    void CommandHandler::RemoveAction(std::string info)
+    void CommandHandler::RemoveAction(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto sprite = Parser::ParseCharacterString(params[0]);
+        auto sprite = args.GetSprite(0);
 
-        for (int i = 1; i < params.size(); i++)
+        for (int i = 1; i < args.Size(); i++)
         {
-            sprite->RemoveAction(params[i]);
+            sprite->RemoveAction(args.Get(i));
         }
     }
 
-    void CommandHandler::RemoveActions(std::string info)
+    void CommandHandler::RemoveActions(const ActionArgs &args)
     {
-        CommandHandler::RemoveAction(info);
+        CommandHandler::RemoveAction(args);
     }
 
-    void CommandHandler::PresentAction(std::string info)
+    void CommandHandler::PresentAction(const ActionArgs &args)
     {
-        auto actions = Parser::ParseActionString(info);
+        auto actions = Parser::ParseActionString(args.GetText());
         Sburb::GetInstance()->GetChooser()->SetChoices(actions);
         Sburb::GetInstance()->GetChooser()->BeginChoosing(Sburb::GetInstance()->GetCamera().x + 20, Sburb::GetInstance()->GetCamera().y + 50);
     }
 
-    void CommandHandler::PresentActions(std::string info)
+    void CommandHandler::PresentActions(const ActionArgs &args)
     {
-        CommandHandler::PresentAction(info);
+        CommandHandler::PresentAction(args);
     }
 
-    void CommandHandler::OpenChest(std::string info)
+    void CommandHandler::OpenChest(const ActionArgs &args)
     {
-        auto params = split(info, ","); // Originally limited to 2? Could be cause for concern?
-
-        auto chest = Sburb::GetInstance()->GetSprite(trim(params[0]));
-        auto item = Sburb::GetInstance()->GetSprite(trim(params[1]));
+        auto chest = args.GetSprite(0);
+        auto item = args.GetSprite(1);
         if (chest->GetAnimation("open"))
         {
             chest->StartAnimation("open");
             if (AssetManager::GetAudioByName("openSound"))
             {
-                CommandHandler::PlaySound("openSound");
+                CommandHandler::PlaySound(ActionArgs("openSound"));
             }
         }
 
         chest->RemoveAction(Sburb::GetInstance()->GetQueue()->GetCurrentAction()->GetName());
-        int offset = params[0].size() + params[1].size() + 2;
-        std::string speech = trim(info.substr(offset, info.size()));
+        std::string speech = args.GetFrom(2);
         speech = speech[0] == '@' ? speech : "@!" + speech;
 
         std::shared_ptr<Action> lastAction;
@@ -398,48 +398,34 @@ namespace SBURB
         Sburb::GetInstance()->PerformAction(newAction);
     }
 
-    void CommandHandler::DeltaSprite(std::string info)
+    void CommandHandler::DeltaSprite(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::shared_ptr<Sprite> sprite = nullptr;
-
-        if (params[0] == "char")
-        {
-            sprite = Sburb::GetInstance()->GetCharacter();
-        }
-        else
-        {
-            sprite = Sburb::GetInstance()->GetSprite(params[0]);
-        }
-
-        int dx = stoi(params[1]);
-        int dy = stoi(params[2]);
+        std::shared_ptr<Sprite> sprite = args.GetSprite(0);
+        int dx = args.GetInt(1);
+        int dy = args.GetInt(2);
         sprite->SetX(sprite->GetX() + dx);
         sprite->SetY(sprite->GetY() + dy);
     }
 
-    void CommandHandler::MoveSprite(std::string info)
+    void CommandHandler::MoveSprite(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::shared_ptr<Sprite> sprite = Parser::ParseCharacterString(params[0]);
-        int newX = stoi(params[1]);
-        int newY = stoi(params[2]);
+        std::shared_ptr<Sprite> sprite = args.GetSprite(0);
+        int newX = args.GetInt(1);
+        int newY = args.GetInt(2);
         sprite->SetX(newX);
         sprite->SetY(newY);
     }
 
-    void CommandHandler::DepthSprite(std::string info)
+    void CommandHandler::DepthSprite(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::shared_ptr<Sprite> sprite = Parser::ParseCharacterString(params[0]);
-        int depth = stoi(params[1]);
+        std::shared_ptr<Sprite> sprite = args.GetSprite(0);
+        int depth = args.GetInt(1);
         sprite->SetDepthing(depth);
     }
 
-    void CommandHandler::PlayMovie(std::string info)
+    void CommandHandler::PlayMovie(const ActionArgs &args)
     {
         // UNSUPPORTED
-        auto params = ParseParams(info);
         Sburb::GetInstance()->PlayMovie(/*Sburb.assets[params[0]]*/);
 
         /*if (params.size()> 0) {
@@ -453,17 +439,17 @@ namespace SBURB
         }*/
     }
 
-    void CommandHandler::RemoveMovie(std::string info)
+    void CommandHandler::RemoveMovie(const ActionArgs &args)
     {
         // NOT SUPPORTED
         Sburb::GetInstance()->SetPlayingMovie(false);
     }
 
-    void CommandHandler::DisableControl(std::string info)
+    void CommandHandler::DisableControl(const ActionArgs &args)
     {
-        if (trim(info).size() > 0)
+        if (args.GetText().size() > 0)
         {
-            Sburb::GetInstance()->SetInputDisabledTrigger(std::make_shared<Trigger>(std::vector({info})));
+            Sburb::GetInstance()->SetInputDisabledTrigger(std::make_shared<Trigger>(std::vector({args.GetText()})));
             Sburb::GetInstance()->SetInputDisabled(false);
         }
         else
@@ -472,14 +458,14 @@ namespace SBURB
         }
     }
 
-    void CommandHandler::EnableControl(std::string info)
+    void CommandHandler::EnableControl(const ActionArgs &args)
     {
         Sburb::GetInstance()->SetInputDisabled(false);
     }
 
-    std::shared_ptr<Trigger> CommandHandler::Macro(std::string info)
+    std::shared_ptr<Trigger> CommandHandler::Macro(const ActionArgs &args)
     {
-        std::vector<std::shared_ptr<Action>> actions = Parser::ParseActionString(info);
+        std::vector<std::shared_ptr<Action>> actions = Parser::ParseActionString(args.GetText());
         std::shared_ptr<Action> action = actions[0];
         if (!action->GetSilent())
         {
@@ -493,24 +479,22 @@ namespace SBURB
         }
     }
 
-    std::shared_ptr<Trigger> CommandHandler::WaitFor(std::string info)
+    std::shared_ptr<Trigger> CommandHandler::WaitFor(const ActionArgs &args)
     {
-        CommandHandler::DisableControl(info);
-        return CommandHandler::Sleep(info);
+        CommandHandler::DisableControl(args);
+        return CommandHandler::Sleep(args);
     }
 
-    std::shared_ptr<Trigger> CommandHandler::Sleep(std::string info)
+    std::shared_ptr<Trigger> CommandHandler::Sleep(const ActionArgs &args)
     {
-        return std::make_shared<Trigger>(std::vector({info}));
+        return std::make_shared<Trigger>(std::vector({args.GetText()}));
     }
 
-    void CommandHandler::PauseActionQueue(std::string info)
+    void CommandHandler::PauseActionQueue(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-
-        for (int i = 0; i < params.size(); i++)
+        for (int i = 0; i < args.Size(); i++)
         {
-            std::shared_ptr<ActionQueue> queue = Sburb::GetInstance()->GetActionQueueById(params[i]);
+            std::shared_ptr<ActionQueue> queue = Sburb::GetInstance()->GetActionQueueById(args.Get(i));
 
             if (queue)
             {
@@ -519,17 +503,16 @@ namespace SBURB
         }
     }
 
-    void CommandHandler::PauseActionQueues(std::string info)
+    void CommandHandler::PauseActionQueues(const ActionArgs &args)
     {
-        CommandHandler::PauseActionQueue(info);
+        CommandHandler::PauseActionQueue(args);
     }
 
-    void CommandHandler::ResumeActionQueue(std::string info)
+    void CommandHandler::ResumeActionQueue(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        for (int i = 0; i < params.size(); i++)
+        for (int i = 0; i < args.Size(); i++)
         {
-            std::shared_ptr<ActionQueue> queue = Sburb::GetInstance()->GetActionQueueById(params[i]);
+            std::shared_ptr<ActionQueue> queue = Sburb::GetInstance()->GetActionQueueById(args.Get(i));
 
             if (queue)
             {
@@ -538,140 +521,128 @@ namespace SBURB
         }
     }
 
-    void CommandHandler::ResumeActionQueues(std::string info)
+    void CommandHandler::ResumeActionQueues(const ActionArgs &args)
     {
-        CommandHandler::ResumeActionQueue(info);
+        CommandHandler::ResumeActionQueue(args);
     }
 
-    void CommandHandler::CancelActionQueue(std::string info)
+    void CommandHandler::CancelActionQueue(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        for (int i = 0; i < params.size(); i++)
+        for (int i = 0; i < args.Size(); i++)
         {
-            Sburb::GetInstance()->RemoveActionQueueById(params[i]);
+            Sburb::GetInstance()->RemoveActionQueueById(args.Get(i));
         }
     }
 
-    void CommandHandler::CancelActionQueues(std::string info)
+    void CommandHandler::CancelActionQueues(const ActionArgs &args)
     {
-        CommandHandler::CancelActionQueue(info);
+        CommandHandler::CancelActionQueue(args);
     }
 
-    void CommandHandler::PauseActionQueueGroup(std::string info)
+    void CommandHandler::PauseActionQueueGroup(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        for (int i = 0; i < params.size(); i++)
+        for (int i = 0; i < args.Size(); i++)
         {
-            Sburb::GetInstance()->ForEachActionQueueInGroup(params[i], [](std::shared_ptr<ActionQueue> queue)
+            Sburb::GetInstance()->ForEachActionQueueInGroup(args.Get(i), [](std::shared_ptr<ActionQueue> queue)
                                                             { queue->SetPaused(true); });
         }
     }
 
-    void CommandHandler::PauseActionQueueGroups(std::string info)
+    void CommandHandler::PauseActionQueueGroups(const ActionArgs &args)
     {
-        CommandHandler::PauseActionQueueGroup(info);
+        CommandHandler::PauseActionQueueGroup(args);
     }
 
-    void CommandHandler::ResumeActionQueueGroup(std::string info)
+    void CommandHandler::ResumeActionQueueGroup(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        for (int i = 0; i < params.size(); i++)
+        for (int i = 0; i < args.Size(); i++)
         {
-            Sburb::GetInstance()->ForEachActionQueueInGroup(params[i], [](std::shared_ptr<ActionQueue> queue)
+            Sburb::GetInstance()->ForEachActionQueueInGroup(args.Get(i), [](std::shared_ptr<ActionQueue> queue)
                                                             { queue->SetPaused(false); });
         }
     }
 
-    void CommandHandler::ResumeActionQueueGroups(std::string info)
+    void CommandHandler::ResumeActionQueueGroups(const ActionArgs &args)
     {
-        CommandHandler::ResumeActionQueueGroup(info);
+        CommandHandler::ResumeActionQueueGroup(args);
     }
 
-    void CommandHandler::CancelActionQueueGroup(std::string info)
+    void CommandHandler::CancelActionQueueGroup(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        for (int i = 0; i < params.size(); i++)
+        for (int i = 0; i < args.Size(); i++)
         {
-            Sburb::GetInstance()->RemoveActionQueuesByGroup(params[i]);
+            Sburb::GetInstance()->RemoveActionQueuesByGroup(args.Get(i));
         }
     }
 
-    void CommandHandler::CancelActionQueueGroups(std::string info)
+    void CommandHandler::CancelActionQueueGroups(const ActionArgs &args)
     {
-        CommandHandler::CancelActionQueueGroup(info);
+        CommandHandler::CancelActionQueueGroup(args);
     }
 
-    void CommandHandler::AddSprite(std::string info)
+    void CommandHandler::AddSprite(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto sprite = Sburb::GetInstance()->GetSprite(params[0]);
-        auto room = Sburb::GetInstance()->GetRoom(params[1]);
+        auto sprite = args.GetSprite(0);
+        auto room = args.GetRoom(1);
 
         room->AddSprite(sprite);
     }
 
-    void CommandHandler::RemoveSprite(std::string info)
+    void CommandHandler::RemoveSprite(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto sprite = Sburb::GetInstance()->GetSprite(params[0]);
-        auto room = Sburb::GetInstance()->GetRoom(params[1]);
+        auto sprite = args.GetSprite(0);
+        auto room = args.GetRoom(1);
 
         room->RemoveSprite(sprite);
     }
 
-    void CommandHandler::CloneSprite(std::string info)
+    void CommandHandler::CloneSprite(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto sprite = Parser::ParseCharacterString(params[0]);
-        std::string newName = params[1];
+        auto sprite = args.GetSprite(0);
+        std::string newName = args.Get(1);
 
         sprite->Clone(newName);
     }
 
-    void CommandHandler::AddWalkable(std::string info)
+    void CommandHandler::AddWalkable(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(params[0]);
-        auto room = Sburb::GetInstance()->GetRoom(params[1]);
+        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(args.Get(0));
+        auto room = args.GetRoom(1);
 
         room->AddWalkable(path);
     }
 
-    void CommandHandler::AddUnwalkable(std::string info)
+    void CommandHandler::AddUnwalkable(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(params[0]);
-        auto room = Sburb::GetInstance()->GetRoom(params[1]);
+        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(args.Get(0));
+        auto room = args.GetRoom(1);
 
         room->AddUnwalkable(path);
     }
 
-    void CommandHandler::AddMotionPath(std::string info)
+    void CommandHandler::AddMotionPath(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(params[0]);
-        auto room = Sburb::GetInstance()->GetRoom(params[7]);
+        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(args.Get(0));
+        auto room = args.GetRoom(7);
 
         room->AddMotionPath(path,
-                            stof(params[1]), stof(params[2]),
-                            stof(params[3]), stof(params[4]),
-                            stof(params[5]), stof(params[6]));
+                            args.GetFloat(1), args.GetFloat(2),
+                            args.GetFloat(3), args.GetFloat(4),
+                            args.GetFloat(5), args.GetFloat(6));
     }
 
-    void CommandHandler::RemoveWalkable(std::string info)
+    void CommandHandler::RemoveWalkable(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(params[0]);
-        auto room = Sburb::GetInstance()->GetRoom(params[1]);
+        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(args.Get(0));
+        auto room = args.GetRoom(1);
 
         room->RemoveWalkable(path);
     }
 
-    void CommandHandler::RemoveUnwalkable(std::string info)
+    void CommandHandler::RemoveUnwalkable(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(params[0]);
-        auto room = Sburb::GetInstance()->GetRoom(params[1]);
+        std::shared_ptr<AssetPath> path = AssetManager::GetPathByName(args.Get(0));
+        auto room = args.GetRoom(1);
 
         room->RemoveUnwalkable(path);
     }
@@ -703,16 +674,15 @@ namespace SBURB
         }
     }
 
-    void CommandHandler::ChangeMode(std::string info)
+    void CommandHandler::ChangeMode(const ActionArgs &args)
     {
-        Sburb::GetInstance()->SetEngineMode(trim(info));
+        Sburb::GetInstance()->SetEngineMode(args.GetText());
     }
 
-    void CommandHandler::LoadStateFile(std::string info)
+    void CommandHandler::LoadStateFile(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto path = params[0];
-        bool keepOld = params[1] == "true";
+        auto path = args.Get(0);
+        bool keepOld = args.GetBool(1);
 
         Serializer::LoadSerialFromXML(path, keepOld);
     }
@@ -722,20 +692,19 @@ namespace SBURB
         Sburb::GetInstance()->SetFading(true);
     }
 
-    void CommandHandler::ChangeRoomRemote(std::string info)
+    void CommandHandler::ChangeRoomRemote(const ActionArgs &args)
     {
         if (Sburb::GetInstance()->GetLoadingRoom())
             return;
         Sburb::GetInstance()->SetLoadingRoom(true); // Only load one room at a time
 
-        auto params = ParseParams(info);
         std::shared_ptr<Action> lastAction;
         std::shared_ptr<Action> newAction = lastAction = std::make_shared<Action>("fadeOut");
 
-        lastAction->SetFollowUp(std::make_shared<Action>("loadStateFile", params[0] + "," + "true"));
+        lastAction->SetFollowUp(std::make_shared<Action>("loadStateFile", args.Get(0) + "," + "true"));
         lastAction = lastAction->GetFollowUp();
 
-        lastAction->SetFollowUp(std::make_shared<Action>("changeRoom", params[1] + "," + params[2] + "," + params[3]));
+        lastAction->SetFollowUp(std::make_shared<Action>("changeRoom", args.Get(1) + "," + args.Get(2) + "," + args.Get(3)));
         lastAction = lastAction->GetFollowUp();
 
         lastAction->SetFollowUp(Sburb::GetInstance()->GetQueue()->GetCurrentAction()->GetFollowUp());
@@ -743,23 +712,21 @@ namespace SBURB
         Sburb::GetInstance()->PerformAction(newAction);
     }
 
-    void CommandHandler::TeleportRemote(std::string info)
+    void CommandHandler::TeleportRemote(const ActionArgs &args)
     {
         if (Sburb::GetInstance()->GetLoadingRoom())
             return;
         Sburb::GetInstance()->SetLoadingRoom(true); // Only load one room at a time
-        CommandHandler::ChangeRoomRemote(info);
+        CommandHandler::ChangeRoomRemote(args);
 
         Sburb::GetInstance()->PlayEffect(Sburb::GetInstance()->GetEffect("teleportEffect"), Sburb::GetInstance()->GetCharacter()->GetX(), Sburb::GetInstance()->GetCharacter()->GetY());
 
-        auto params = ParseParams(info);
-        Sburb::GetInstance()->GetQueue()->GetCurrentAction()->GetFollowUp()->GetFollowUp()->SetFollowUp(std::make_shared<Action>("playEffect", "teleportEffect," + params[2] + "," + params[3], "", "", Sburb::GetInstance()->GetQueue()->GetCurrentAction()->GetFollowUp()->GetFollowUp()->GetFollowUp()));
+        Sburb::GetInstance()->GetQueue()->GetCurrentAction()->GetFollowUp()->GetFollowUp()->SetFollowUp(std::make_shared<Action>("playEffect", "teleportEffect," + args.Get(2) + "," + args.Get(3), "", "", Sburb::GetInstance()->GetQueue()->GetCurrentAction()->GetFollowUp()->GetFollowUp()->GetFollowUp()));
     }
 
-    void CommandHandler::SetButtonState(std::string info)
+    void CommandHandler::SetButtonState(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        Sburb::GetInstance()->GetButton(params[0])->SetState(params[1]);
+        Sburb::GetInstance()->GetButton(args.Get(0))->SetState(args.Get(1));
     }
 
     void CommandHandler::SkipDialog()
@@ -767,101 +734,91 @@ namespace SBURB
         Sburb::GetInstance()->GetDialoger()->SkipAll();
     }
 
-    void CommandHandler::Follow(std::string info)
+    void CommandHandler::Follow(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::shared_ptr<Character> follower = std::static_pointer_cast<Character>(Parser::ParseCharacterString(params[0]));
-        std::shared_ptr<Character> leader = std::static_pointer_cast<Character>(Parser::ParseCharacterString(params[1]));
+        std::shared_ptr<Character> follower = std::static_pointer_cast<Character>(args.GetSprite(0));
+        std::shared_ptr<Character> leader = std::static_pointer_cast<Character>(args.GetSprite(1));
 
         follower->Follow(leader);
     }
 
-    void CommandHandler::Unfollow(std::string info)
+    void CommandHandler::Unfollow(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto follower = std::static_pointer_cast<Character>(Parser::ParseCharacterString(params[0]));
+        auto follower = std::static_pointer_cast<Character>(args.GetSprite(0));
         follower->Unfollow();
     }
 
-    void CommandHandler::AddOverlay(std::string info)
+    void CommandHandler::AddOverlay(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto sprite = Sburb::GetInstance()->GetSprite(params[0]);
+        auto sprite = args.GetSprite(0);
         sprite->SetX(Sburb::GetInstance()->GetCamera().x);
         sprite->SetY(Sburb::GetInstance()->GetCamera().y);
 
         Sburb::GetInstance()->GetCurrentRoom()->AddSprite(sprite);
     }
 
-    void CommandHandler::RemoveOverlay(std::string info)
+    void CommandHandler::RemoveOverlay(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto sprite = Sburb::GetInstance()->GetSprite(params[0]);
+        auto sprite = args.GetSprite(0);
         Sburb::GetInstance()->GetCurrentRoom()->RemoveSprite(sprite);
     }
 
-    void CommandHandler::Save(std::string info)
+    void CommandHandler::Save(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        bool automatic = params.size() > 0 && params[0] == "true";
-        bool local = params.size() > 1 && params[1] == "true";
+        bool automatic = args.GetBool(0);
+        bool local = args.GetBool(1);
 
         Sburb::GetInstance()->SaveStateToStorage(Sburb::GetInstance()->GetCharacter()->GetName() + ", " + Sburb::GetInstance()->GetCurrentRoom()->GetName(), automatic, local);
     }
 
-    void CommandHandler::Load(std::string info)
+    void CommandHandler::Load(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        bool automatic = params.size() > 0 && params[0] == "true";
-        bool local = params.size() > 1 && params[1] == "true";
+        bool automatic = args.GetBool(0);
+        bool local = args.GetBool(1);
 
         Sburb::GetInstance()->LoadStateFromStorage(automatic, local);
     }
 
-    void CommandHandler::SaveOrLoad(std::string info)
+    void CommandHandler::SaveOrLoad(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        bool local = params.size() > 0 && params[0] == "true";
+        bool local = args.GetBool(0);
         std::vector<std::shared_ptr<Action>> actions = {};
 
         if (Sburb::GetInstance()->IsStateInStorage(false, local))
         {
-            actions.push_back(std::make_shared<Action>("load", "false, " + local, "Load " + Sburb::GetInstance()->GetStateDescription(false)));
+            actions.push_back(std::make_shared<Action>("load", std::string("false, ") + (local ? "true" : "false"), "Load " + Sburb::GetInstance()->GetStateDescription(false, local)));
         }
 
         if (Sburb::GetInstance()->IsStateInStorage(true, local))
         {
-            actions.push_back(std::make_shared<Action>("load", "true, " + local, "Load " + Sburb::GetInstance()->GetStateDescription(true)));
+            actions.push_back(std::make_shared<Action>("load", std::string("true, ") + (local ? "true" : "false"), "Load " + Sburb::GetInstance()->GetStateDescription(true, local)));
         }
 
-        actions.push_back(std::make_shared<Action>("save", "false," + local, "Save"));
+        actions.push_back(std::make_shared<Action>("save", std::string("false, ") + (local ? "true" : "false"), "Save"));
         actions.push_back(std::make_shared<Action>("cancel", "", "Cancel"));
 
         Sburb::GetInstance()->GetChooser()->SetChoices(actions);
         Sburb::GetInstance()->GetChooser()->BeginChoosing(Sburb::GetInstance()->GetCamera().x + 20, Sburb::GetInstance()->GetCamera().y + 50);
     }
 
-    void CommandHandler::SetGameState(std::string info)
+    void CommandHandler::SetGameState(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-
         // TODO: there should be a check to make sure the gameState key
         // doesn't contain &, <, or >
 
-        Sburb::GetInstance()->SetGameState(params[0], params[1]);
+        Sburb::GetInstance()->SetGameState(args.Get(0), args.Get(1));
     }
 
-    void CommandHandler::GoBack(std::string info)
+    void CommandHandler::GoBack(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto character = std::static_pointer_cast<Character>(Parser::ParseCharacterString(params[0]));
+        auto character = std::static_pointer_cast<Character>(args.GetSprite(0));
         character->SetX(character->GetOldX());
         character->SetY(character->GetOldY());
     }
 
-    void CommandHandler::Try(std::string info)
+    void CommandHandler::Try(const ActionArgs &args)
     {
-        std::vector<std::shared_ptr<Trigger>> triggers = Parser::ParseTriggerString(info);
+        std::vector<std::shared_ptr<Trigger>> triggers = Parser::ParseTriggerString(args.GetText());
 
         for (int i = 0; i < triggers.size(); i++)
         {
@@ -875,11 +832,10 @@ namespace SBURB
         }
     }
 
-    void CommandHandler::Walk(std::string info)
+    void CommandHandler::Walk(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        auto character = std::static_pointer_cast<Character>(Parser::ParseCharacterString(params[0]));
-        std::string dir = params[1];
+        auto character = std::static_pointer_cast<Character>(args.GetSprite(0));
+        std::string dir = args.Get(1);
 
         if (dir == "Up")
         {
@@ -899,15 +855,14 @@ namespace SBURB
         }
     }
 
-    void CommandHandler::OpenLink(std::string info)
+    void CommandHandler::OpenLink(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::string url = params[0];
+        std::string url = args.Get(0);
         std::string text;
 
-        if (params.size() >= 1 && params[1] != "")
+        if (args.Size() >= 1 && args.Get(1) != "")
         {
-            text = params[1];
+            text = args.Get(1);
         }
         else
         {
@@ -923,11 +878,10 @@ namespace SBURB
         Sburb::GetInstance()->GetChooser()->BeginChoosing(Sburb::GetInstance()->GetCamera().x + 200, Sburb::GetInstance()->GetCamera().y + 250);
     }
 
-    void CommandHandler::OpenDirect(std::string info)
+    void CommandHandler::OpenDirect(const ActionArgs &args)
     {
-        auto params = ParseParams(info);
-        std::string url = Parser::ParseURLString(params[0]);
-        std::string text = params[1];
+        std::string url = Parser::ParseURLString(args.Get(0));
+        std::string text = args.Get(1);
 
 #if defined(_WIN32) || defined(WIN32)
         ShellExecute(0, 0, std::wstring(url.begin(), url.end()).c_str(), 0, 0, SW_SHOW);
@@ -935,7 +889,7 @@ namespace SBURB
         // TODO: Add support for opening URL on other OS's.
     }
 
-    void CommandHandler::Cancel(std::string info)
+    void CommandHandler::Cancel(const ActionArgs &args)
     {
     }
 }
\ No newline at end of file
@@ -36,6 +36,7 @@ namespace SBURB
 		this->dialogSide = "Left";
 		this->graphic = nullptr;
 		this->box = nullptr;
+		this->buttonsEpoch = 0;
 		this->defaultBox = nullptr;
 
 		this->type = type;
@@ -132,8 +133,9 @@ namespace SBURB
 
 		if (this->type == "social")
 		{
-			Sburb::GetInstance()->GetButton("spadeButton")->StartAnimation("state0");
-			Sburb::GetInstance()->GetButton("heartButton")->StartAnimation("state0");
+			this->ResolveSocialButtons();
+			this->spadeButton->StartAnimation("state0");
+			this->heartButton->StartAnimation("state0");
 
 			if (this->actor != "" && !this->choices[this->currentDialog])
 			{
@@ -143,11 +145,11 @@ namespace SBURB
 			{
 				if (this->choices[this->currentDialog] == 1)
 				{
-					Sburb::GetInstance()->GetButton("heartButton")->StartAnimation("state1");
+					this->heartButton->StartAnimation("state1");
 				}
 				else
 				{
-					Sburb::GetInstance()->GetButton("spadeButton")->StartAnimation("state1");
+					this->spadeButton->StartAnimation("state1");
 				}
 			}
 		}
@@ -190,7 +192,7 @@ namespace SBURB
 			{
 				std::shared_ptr<AssetGraphic> img = AssetManager::GetGraphicByName(resource);
 				this->graphic = std::make_shared<Sprite>();
-				this->graphic->AddAnimation(std::make_shared<Animation>("image", img->GetName(), 0, 0, (int)img->GetAsset()->getSize().x, (int)img->GetAsset()->getSize().y, 0, 1, "1"));
+				this->graphic->AddAnimation(std::make_shared<Animation>("image", img->GetName(), 0, 0, (int)img->GetSize().x, (int)img->GetSize().y, 0, 1, "1"));
 				this->graphic->StartAnimation("image");
 			}
 		}
@@ -376,21 +378,26 @@ namespace SBURB
 		return sprite->GetY() == pos.y && sprite->GetX() == pos.x;
 	}
 
-	void Dialoger::Update()
+	void Dialoger::ResolveSocialButtons()
 	{
-		std::shared_ptr<SpriteButton> closeButton;
-		std::shared_ptr<SpriteButton> spadeButton;
-		std::shared_ptr<SpriteButton> heartButton;
-		std::shared_ptr<SpriteButton> bubbleButton;
-		std::shared_ptr<SpriteButton> hashTagBar;
+		// A load keeping the old state may have replaced the buttons with new ones
+		uint32_t epoch = Sburb::GetInstance()->GetBindingEpoch();
+		if (this->hashTagBar && this->buttonsEpoch == epoch)
+			return;
+
+		this->buttonsEpoch = epoch;
+		this->closeButton = Sburb::GetInstance()->GetButton("closeButton");
+		this->spadeButton = Sburb::GetInstance()->GetButton("spadeButton");
+		this->heartButton = Sburb::GetInstance()->GetButton("heartButton");
+		this->bubbleButton = Sburb::GetInstance()->GetButton("bubbleButton");
+		this->hashTagBar = Sburb::GetInstance()->GetButton("hashTagBar");
+	}
 
+	void Dialoger::Update()
+	{
 		if (this->type == "social")
 		{
-			closeButton = Sburb::GetInstance()->GetButton("closeButton");
-			spadeButton = Sburb::GetInstance()->GetButton("spadeButton");
-			heartButton = Sburb::GetInstance()->GetButton("heartButton");
-			bubbleButton = Sburb::GetInstance()->GetButton("bubbleButton");
-			hashTagBar = Sburb::GetInstance()->GetButton("hashTagBar");
+			this->ResolveSocialButtons();
 		}
 
 		bool init = false;
@@ -580,8 +587,8 @@ namespace SBURB
 		{
 			std::shared_ptr<AssetGraphic> boxAsset = AssetManager::GetGraphicByName(box);
 
-			dialogBox = std::make_shared<Sprite>(std::string("dialogBox"), Sburb::GetInstance()->window->getSize().x + 1, 1000, boxAsset->GetAsset()->getSize().x, boxAsset->GetAsset()->getSize().y, 0, 0, 0);
-			dialogBox->AddAnimation(std::make_shared<Animation>(std::string("image"), boxAsset->GetName(), 0, 0, boxAsset->GetAsset()->getSize().x, boxAsset->GetAsset()->getSize().y, 0, 1, "1"));
+			dialogBox = std::make_shared<Sprite>(std::string("dialogBox"), Sburb::GetInstance()->GetViewSize().x + 1, 1000, boxAsset->GetSize().x, boxAsset->GetSize().y, 0, 0, 0);
+			dialogBox->AddAnimation(std::make_shared<Animation>(std::string("image"), boxAsset->GetName(), 0, 0, boxAsset->GetSize().x, boxAsset->GetSize().y, 0, 1, "1"));
 			dialogBox->StartAnimation("image");
 		}
 
@@ -598,32 +605,31 @@ namespace SBURB
 		this->box = dialogBox;
 	}
 
-	std::string Dialoger::Serialize(std::string output)
+	void Dialoger::Serialize(SerialWriter &out)
 	{
-		output += "\n<dialoger " +
-				  Serializer::SerializeAttribute("hiddenPos", this->hiddenPos) +
-				  Serializer::SerializeAttribute("alertPos", this->alertPos) +
-				  Serializer::SerializeAttribute("talkPosLeft", this->talkPosLeft) +
-				  Serializer::SerializeAttribute("talkPosRight", this->talkPosRight) +
-				  Serializer::SerializeAttribute("spriteStartRight", this->spriteStartRight) +
-				  Serializer::SerializeAttribute("spriteEndRight", this->spriteEndRight) +
-				  Serializer::SerializeAttribute("spriteStartLeft", this->spriteStartLeft) +
-				  Serializer::SerializeAttribute("spriteEndLeft", this->spriteEndLeft) +
-				  Serializer::SerializeAttribute("alertTextDimensions", this->alertTextDimensions) +
-				  Serializer::SerializeAttribute("leftTextDimensions", this->leftTextDimensions) +
-				  Serializer::SerializeAttribute("rightTextDimensions", this->rightTextDimensions);
-		output += Serializer::SerializeAttribute("type", this->type);
-		output += "box='" + this->box->GetAnimation()->GetSheet()->GetName() + "' ";
-		output += ">";
-		output += "</dialoger>";
-		return output;
+		out << "\n<dialoger ";
+		Serializer::SerializeAttribute(out, "hiddenPos", this->hiddenPos);
+		Serializer::SerializeAttribute(out, "alertPos", this->alertPos);
+		Serializer::SerializeAttribute(out, "talkPosLeft", this->talkPosLeft);
+		Serializer::SerializeAttribute(out, "talkPosRight", this->talkPosRight);
+		Serializer::SerializeAttribute(out, "spriteStartRight", this->spriteStartRight);
+		Serializer::SerializeAttribute(out, "spriteEndRight", this->spriteEndRight);
+		Serializer::SerializeAttribute(out, "spriteStartLeft", this->spriteStartLeft);
+		Serializer::SerializeAttribute(out, "spriteEndLeft", this->spriteEndLeft);
+		Serializer::SerializeAttribute(out, "alertTextDimensions", this->alertTextDimensions);
+		Serializer::SerializeAttribute(out, "leftTextDimensions", this->leftTextDimensions);
+		Serializer::SerializeAttribute(out, "rightTextDimensions", this->rightTextDimensions);
+		Serializer::SerializeAttribute(out, "type", this->type);
+		out << "box='" << this->box->GetAnimation()->GetSheet()->GetName() << "' ";
+		out << ">";
+		out << "</dialoger>";
 	}
 
 	void Dialoger::draw(sf::RenderTarget &target, sf::RenderStates states) const
 	{
-		if (this->type == "social")
+		if (this->type == "social" && this->hashTagBar)
 		{
-			target.draw(*Sburb::GetInstance()->GetSprite("hashTagBar"), states);
+			target.draw(*this->hashTagBar, states);
 		}
 
 		target.draw(*this->box, states);
@@ -637,11 +643,11 @@ namespace SBURB
 		{
 			target.draw(*this->dialog, states);
 
-			if (this->type == "social")
+			if (this->type == "social" && this->hashTagBar)
 			{
 				if (this->queue.size() > 0)
 				{
-					target.draw(*Sburb::GetInstance()->GetButton("closeButton"), states);
+					target.draw(*this->closeButton, states);
 				}
 
 				if (this->dialog->GetStart() != this->dialog->GetEnd())
@@ -650,9 +656,9 @@ namespace SBURB
 
 					if (this->queue.size() == 0 && this->actor != "")
 					{
-						target.draw(*Sburb::GetInstance()->GetButton("spadeButton"), states);
-						target.draw(*Sburb::GetInstance()->GetButton("heartButton"), states);
-						target.draw(*Sburb::GetInstance()->GetButton("bubbleButton"), states);
+						target.draw(*this->spadeButton, states);
+						target.draw(*this->heartButton, states);
+						target.draw(*this->bubbleButton, states);
 					}
 				}
 			}
@@ -0,0 +1,36 @@
+#include "EntityRef.h"
+#include "Sburb.h"
+
+namespace SBURB
+{
+    template <>
+    std::shared_ptr<Sprite> EntityRef<Sprite>::Get()
+    {
+        Sburb *game = Sburb::GetInstance();
+
+        if (this->character)
+            return game->GetCharacter();
+
+        if (this->epoch != game->GetBindingEpoch())
+        {
+            this->handle = game->GetSpriteHandle(this->name);
+            this->epoch = game->GetBindingEpoch();
+        }
+
+        return game->GetSprite(this->handle);
+    }
+
+    template <>
+    std::shared_ptr<Room> EntityRef<Room>::Get()
+    {
+        Sburb *game = Sburb::GetInstance();
+
+        if (this->epoch != game->GetBindingEpoch())
+        {
+            this->handle = game->GetRoomHandle(this->name);
+            this->epoch = game->GetBindingEpoch();
+        }
+
+        return game->GetRoom(this->handle);
+    }
+}
@@ -1,8 +1,53 @@
 #include "Event.h"
+#include "GameState.h"
 
 namespace SBURB {
-    Event::Event() {
+    EventCondition::EventCondition(const std::string &query) {
+        // Checked in this order, so "!=" wins over "="
+        static const std::pair<const char*, Operator> tokens[] = {
+            {">", Greater}, {"GREATER", Greater}, {"<", Less}, {"LESS", Less}, {"!=", NotEqual}, {"=", Equal}
+        };
+
+        this->op = Invalid;
+        this->targetNumber = 0;
+        this->targetNumeric = false;
+
+        for (auto& token : tokens) {
+            size_t at = query.find(token.first);
+            if (at != std::string::npos) {
+                this->op = token.second;
+                this->prop = trim(query.substr(0, at));
+                this->target = trim(query.substr(at + strlen(token.first)));
+                break;
+            }
+        }
+
+        this->targetNumeric = GameState::ParseNumber(this->target, this->targetNumber);
+    }
 
+    bool EventCondition::Test(const std::string &value, int number, bool numeric) const {
+        switch (this->op) {
+        case Greater:
+            return numeric && this->targetNumeric && number > this->targetNumber;
+        case Less:
+            return numeric && this->targetNumeric && number < this->targetNumber;
+        case NotEqual:
+            return value != this->target;
+        case Equal:
+            return value == this->target;
+        default:
+            return false;
+        }
+    }
+
+    bool EventCondition::Test(const std::string &value) const {
+        int number = 0;
+        bool numeric = this->IsNumeric() && GameState::ParseNumber(value, number);
+        return this->Test(value, number, numeric);
+    }
+
+    Event::Event() {
+        this->canSerialize = false;
     }
 
     Event::~Event() {
@@ -43,7 +43,7 @@ namespace SBURB {
 		}
 
 		if (type == "noActions") {
-			return std::make_shared<EventNoActions>();
+			return std::make_shared<EventNoActions>(params.size() > 1 ? params[1] : "");
 		}
 		
 		if (type == "nudge") {
@@ -59,7 +59,7 @@ namespace SBURB {
 		}
 
 		if (type == "time") {
-			return std::make_shared<EventTime>();
+			return std::make_shared<EventTime>(params.size() > 1 ? stoi(params[1]) : 0);
 		}
 
 		if (type == "withinRange") {
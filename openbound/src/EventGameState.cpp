@@ -1,23 +1,12 @@
 #include "EventGameState.h"
 #include "Sburb.h"
 
-// NOTE: This can obviously be optimized in the future.
 namespace SBURB {
-    EventGameState::EventGameState(std::string query) {
+    EventGameState::EventGameState(std::string query) : condition(query) {
         this->canSerialize = false;
 
-        this->token = "";
-        if (query.find(">") != -1) this->token = ">";
-        else if (query.find("GREATER") != -1) this->token = "GREATER";
-        else if (query.find("<") != -1) this->token = "<";
-        else if (query.find("LESS") != -1) this->token = "LESS";
-        else if (query.find("!=") != -1) this->token = "!=";
-        else if (query.find("=") != -1) this->token = "=";
-
-        auto queryParts = split(query, this->token);
-
-        this->prop = trim(queryParts[0]);
-        this->target = trim(queryParts[1]);
+        // Resolved once, the handle outlives any reload of the game state
+        this->handle = Sburb::GetInstance()->GetGameStateTable().GetHandle(this->condition.GetProp());
     }
 
     EventGameState::~EventGameState() {
@@ -28,20 +17,10 @@ namespace SBURB {
     }
 
     bool EventGameState::CheckCompletion() {
-        if (token == ">" || token == "GREATER") {
-            return std::stoi(Sburb::GetInstance()->GetGameState(this->prop)) > std::stoi(target);
-        }
-
-        if (token == "<" || token == "LESS") {
-            return std::stoi(Sburb::GetInstance()->GetGameState(this->prop)) < std::stoi(target);
-        }
-
-        if (token == "!=") {
-            return Sburb::GetInstance()->GetGameState(this->prop) != target;
-        }
+        const GameState& gameState = Sburb::GetInstance()->GetGameStateTable();
 
-        if (token == "=") {
-            return Sburb::GetInstance()->GetGameState(this->prop) == target;
-        }
+        int number = 0;
+        bool numeric = gameState.GetNumber(this->handle, number);
+        return this->condition.Test(gameState.Get(this->handle), number, numeric);
     }
-}
\ No newline at end of file
+}
@@ -2,8 +2,7 @@
 #include "Sburb.h"
 
 namespace SBURB {
-    EventInBox::EventInBox(std::string spriteName, int x, int y, int width, int height) {
-        this->spriteName = spriteName;
+    EventInBox::EventInBox(std::string spriteName, int x, int y, int width, int height) : entity(spriteName) {
         this->x = x;
         this->y = y;
         this->width = width;
@@ -16,19 +15,14 @@ namespace SBURB {
     }
 
     void EventInBox::Reset() {
-        if (this->spriteName == "char") {
-            this->entity = nullptr;
-        }
-        else {
-            this->entity = Sburb::GetInstance()->GetSprite(this->spriteName);
-        }
+
     }
 
     bool EventInBox::CheckCompletion() {
-        auto entity = this->entity;
+        auto entity = this->entity.Get();
 
-        if (this->spriteName == "char") {
-            entity = Sburb::GetInstance()->GetCharacter();
+        if (!entity) {
+            return false;
         }
 
         return entity->GetX() >= x && entity->GetY() >= y && entity->GetX() <= x + width && entity->GetY() <= y + height;
@@ -2,10 +2,8 @@
 #include "Sburb.h"
 
 namespace SBURB {
-    EventPlayed::EventPlayed(std::string spriteName) {
+    EventPlayed::EventPlayed(std::string spriteName) : entity(spriteName) {
         this->canSerialize = false;
-        this->spriteName = spriteName;
-        this->entity = nullptr;
     }
 
     EventPlayed::~EventPlayed() {
@@ -13,19 +11,14 @@ namespace SBURB {
     }
 
     void EventPlayed::Reset() {
-        if (this->spriteName == "char") {
-            this->entity = nullptr;
-        }
-        else {
-            this->entity = Sburb::GetInstance()->GetSprite(spriteName);
-        }
+
     }
 
     bool EventPlayed::CheckCompletion() {
-        auto entity = this->entity;
+        auto entity = this->entity.Get();
 
-        if (this->spriteName == "char") {
-            entity = Sburb::GetInstance()->GetCharacter();
+        if (!entity || !entity->GetAnimation()) {
+            return false;
         }
 
         return entity->GetAnimation()->HasPlayed();
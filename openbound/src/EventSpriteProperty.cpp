@@ -2,21 +2,12 @@
 #include "Sburb.h"
 
 namespace SBURB {
-    EventSpriteProperty::EventSpriteProperty(std::string spriteName, std::string query) {
+    EventSpriteProperty::EventSpriteProperty(std::string spriteName, std::string query) : entity(spriteName), condition(query) {
         this->canSerialize = false;
 
-        this->token = "";
-        if (query.find(">") != -1) this->token = ">";
-        else if (query.find("GREATER") != -1) this->token = "GREATER";
-        else if (query.find("<") != -1) this->token = "<";
-        else if (query.find("LESS") != -1) this->token = "LESS";
-        else if (query.find("!=") != -1) this->token = "!=";
-        else if (query.find("=") != -1) this->token = "=";
-
-        auto queryParts = split(query, this->token);
-
-        this->prop = trim(queryParts[0]);
-        this->target = trim(queryParts[1]);
+        if (this->condition.GetProp() == "x") this->property = Property::X;
+        else if (this->condition.GetProp() == "y") this->property = Property::Y;
+        else this->property = Property::Other;
     }
     
     EventSpriteProperty::~EventSpriteProperty() {
@@ -24,35 +15,23 @@ namespace SBURB {
     }
 
     void EventSpriteProperty::Reset() {
-        if (this->spriteName == "char") {
-            this->entity = nullptr;
-        }
-        else {
-            this->entity = Sburb::GetInstance()->GetSprite(this->spriteName);
-        }
+
     }
 
     bool EventSpriteProperty::CheckCompletion() {
-        auto entity = this->entity;
+        auto entity = this->entity.Get();
 
-        if (this->spriteName == "char") {
-            entity = Sburb::GetInstance()->GetCharacter();
+        if (!entity) {
+            return false;
         }
 
-        if (token == ">" || token == "GREATER") {
-            return std::stoi(entity->GetProp(this->prop)) > std::stoi(target);
-        }
-
-        if (token == "<" || token == "LESS") {
-            return std::stoi(entity->GetProp(this->prop)) < std::stoi(target);
-        }
+        if (this->property != Property::Other) {
+            int number = this->property == Property::X ? entity->GetX() : entity->GetY();
 
-        if (token == "!=") {
-            return entity->GetProp(this->prop) != target;
+            // Equality still compares text, only build it when needed
+            return this->condition.IsNumeric() ? this->condition.Test("", number, true) : this->condition.Test(std::to_string(number));
         }
 
-        if (token == "=") {
-            return entity->GetProp(this->prop) == target;
-        }
+        return this->condition.Test(entity->GetProp(this->condition.GetProp()));
     }
-}
\ No newline at end of file
+}
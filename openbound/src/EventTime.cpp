@@ -1,10 +1,14 @@
 #include "EventTime.h"
+#include "Sburb.h"
 
 namespace SBURB {
     EventTime::EventTime(int time) {
         this->canSerialize = true;
         this->originalTime = time;
-        this->time = 0;
+        this->deadline = 0;
+        this->armed = false;
+        this->remaining = 0;
+        this->paused = false;
     }
 
     EventTime::~EventTime() {
@@ -12,15 +16,59 @@ namespace SBURB {
     }
 
     void EventTime::Reset() {
-        this->time = this->originalTime;
+        // Triggers reset when they are parsed, long before anyone is around to check them.
+        // The clock starts with the first check instead, like it did when every check counted down.
+        this->armed = false;
+        this->paused = false;
+    }
+
+    void EventTime::Pause() {
+        if (!this->armed || this->paused) {
+            return;
+        }
+
+        uint32_t tick = Sburb::GetInstance()->GetTickCount();
+        this->remaining = this->deadline > tick ? this->deadline - tick : 0;
+        this->paused = true;
+    }
+
+    void EventTime::Resume() {
+        if (!this->paused) {
+            return;
+        }
+
+        this->deadline = Sburb::GetInstance()->GetTickCount() + this->remaining;
+        this->paused = false;
+        Signals::Schedule(this->deadline);
     }
 
     bool EventTime::CheckCompletion() {
-        this->time--;
-        return this->time <= 0;
+        if (this->paused) {
+            return false;
+        }
+
+        uint32_t tick = Sburb::GetInstance()->GetTickCount();
+
+        if (!this->armed) {
+            // Counted in ticks rather than checks, so we don't need asking every tick to keep time
+            this->deadline = tick + std::max(this->originalTime, 0);
+            this->armed = true;
+            Signals::Schedule(this->deadline);
+        }
+
+        return tick >= this->deadline;
     }
 
     std::string EventTime::Serialize() {
-        return "time," + this->time;
+        if (!this->armed) {
+            return "time," + std::to_string(std::max(this->originalTime, 0));
+        }
+
+        if (this->paused) {
+            return "time," + std::to_string(this->remaining);
+        }
+
+        uint32_t tick = Sburb::GetInstance()->GetTickCount();
+        return "time," + std::to_string(this->deadline > tick ? this->deadline - tick : 0);
     }
 }
\ No newline at end of file
@@ -1,13 +1,10 @@
 #include "EventWithinRange.h"
 #include "Sprite.h"
 #include "Sburb.h"
-#include "Parser.h"
 
 namespace SBURB {
-    EventWithinRange::EventWithinRange(std::string spriteName1, std::string spriteName2, float distance) {
+    EventWithinRange::EventWithinRange(std::string spriteName1, std::string spriteName2, float distance) : sprite1(spriteName1), sprite2(spriteName2) {
         this->canSerialize = false;
-        this->spriteName1 = spriteName1;
-        this->spriteName2 = spriteName2;
         this->distance = distance;
     }
 
@@ -20,8 +17,13 @@ namespace SBURB {
     }
 
     bool EventWithinRange::CheckCompletion() {
-        std::shared_ptr<Sprite> sprite1 = Parser::ParseCharacterString(spriteName1);
-        std::shared_ptr<Sprite> sprite2 = Parser::ParseCharacterString(spriteName2);
+        std::shared_ptr<Sprite> sprite1 = this->sprite1.Get();
+        std::shared_ptr<Sprite> sprite2 = this->sprite2.Get();
+
+        if (!sprite1 || !sprite2) {
+            return false;
+        }
+
         float xDist = sprite1->GetX() - sprite2->GetX();
         float yDist = sprite1->GetY() - sprite2->GetY();
         return sqrt(xDist * xDist + yDist * yDist) <= this->distance;
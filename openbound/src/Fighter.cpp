@@ -125,19 +125,17 @@ namespace SBURB {
 		return sqrt(xDiff * xDiff / w2 / w1 + yDiff * yDiff / h2 / h1) < 2;
 	}
 
-	std::map<std::string, Vector2> Fighter::GetBoundaryQueries(int dx, int dy) {
+	void Fighter::GetBoundaryQueries(BoundaryQuery& query, int dx, int dy) {
 		int x = this->x + dx;
 		int y = this->y + dy;
-		int queryCount = 8;
-		int angleDiff = 2 * PI / queryCount;
+		int queryCount = BoundaryQuery::MAX_POINTS;
+		float angleDiff = 2 * PI / queryCount;
 
-		std::map<std::string, Vector2> queries = {};
-		
-		for (int i = 0, theta = 0; i < queryCount; i++, theta += angleDiff) {
-			queries[std::to_string(i)] = Vector2(x + cos(theta) * this->width / 2, y + sin(theta) * this->height / 2);
+		query.count = 0;
+		float theta = 0;
+		for (int i = 0; i < queryCount; i++, theta += angleDiff) {
+			query.Push(x + cos(theta) * this->width / 2, y + sin(theta) * this->height / 2);
 		}
-
-		return queries;
 	}
 
 	bool Fighter::TryToMove() {
@@ -163,8 +161,8 @@ namespace SBURB {
 		}*/
 		float dx = vx;
 		float dy = vy;
-		this->x += vx;
-		this->y += vy;
+		this->SetX(this->x + vx);
+		this->SetY(this->y + vy);
 
 		std::shared_ptr<Room> room = Sburb::GetInstance()->GetCurrentRoom();
 
@@ -180,12 +178,12 @@ namespace SBURB {
 				ty -= (dy - yOff) * 0.1;
 			}
 			if (room->Collides(this, tx, ty)) {
-				this->x -= dx;
-				this->y -= dy;
+				this->SetX(this->x - dx);
+				this->SetY(this->y - dy);
 				return false;
 			}
-			this->x += tx;
-			this->y += ty;
+			this->SetX(this->x + tx);
+			this->SetY(this->y + ty);
 			dx += tx;
 			dy += ty;
 
@@ -196,29 +194,25 @@ namespace SBURB {
 			this->vy *= 0.9;
 		}
 
-		std::map<std::string, bool> queries;
-		room->IsInBoundsBatch(this->GetBoundaryQueries(), &queries);
+		BoundaryQuery query;
+		this->GetBoundaryQueries(query);
+		room->IsInBoundsBatch(query);
 
-		float queryCount = 8;
 		bool collided = false;
 		float hitX = 0;
 		float hitY = 0;
-		float angleDiff = 2 * PI / queryCount;
+		float angleDiff = 2 * PI / query.count;
 
 		float theta = 0;
-		int currentQuery = 0;
-
-		for (auto query : queries) {
-			if (currentQuery >= queryCount) break;
 
-			if (!query.second) {
+		for (int i = 0; i < query.count; i++) {
+			if (!query.results[i]) {
 				hitX += cos(theta);
 				hitY += sin(theta);
 				collided = true;
 			}
 
 			theta += angleDiff;
-			currentQuery++;
 		}
 
 		if (collided) {
@@ -236,13 +230,13 @@ namespace SBURB {
 			}
 			
 			if (timeout >= 20 || room->Collides(this, tx, ty)) {
-				this->x -= dx;
-				this->y -= dy;
+				this->SetX(this->x - dx);
+				this->SetY(this->y - dy);
 				return false;
 			}
 
-			this->x += tx;
-			this->y += ty;
+			this->SetX(this->x + tx);
+			this->SetY(this->y + ty);
 			dx += tx;
 			dy += ty;
 
@@ -255,32 +249,27 @@ namespace SBURB {
 		return true;
 	}
 
-	std::string Fighter::Serialize(std::string output) {
-		int animationCount = 0;
-		for (auto anim : this->animations) {
-			animationCount++;
+	void Fighter::Serialize(SerialWriter &out) {
+		out << "<fighter ";
+		Serializer::SerializeAttribute(out, "name", this->name);
+		Serializer::SerializeAttribute(out, "x", this->x);
+		Serializer::SerializeAttribute(out, "y", this->y);
+		Serializer::SerializeAttribute(out, "width", this->width);
+		Serializer::SerializeAttribute(out, "height", this->height);
+		Serializer::SerializeAttribute(out, "facing", this->facing);
+		if (this->animations.size() > 1) {
+			out << "state='" << this->state << "' ";
 		}
+		out << ">";
 
-		output = output + "<fighter " +
-			Serializer::SerializeAttribute("name", this->name) +
-			Serializer::SerializeAttribute("x", this->x) +
-			Serializer::SerializeAttribute("y", this->y) +
-			Serializer::SerializeAttribute("width", this->width) +
-			Serializer::SerializeAttribute("height", this->height) + 
-			Serializer::SerializeAttribute("facing", this->facing) +
-			(animationCount > 1 ? "state='" + this->state + "' " : "") +
-			">";
-
-		for (auto anim : this->animations) {
-			output = anim.second->Serialize(output);
+		for (const auto &anim : this->animations) {
+			anim.second->Serialize(out);
 		}
 
-		for (auto action : this->actions) {
-			output = action->Serialize(output);
+		for (const auto &action : this->actions) {
+			action->Serialize(out);
 		}
-		
-		output = output + "</fighter>";
-		
-		return output;
+
+		out << "</fighter>";
 	}
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "GameState.h"
+#include "Signals.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+
+namespace SBURB
+{
+    static const std::string emptyValue = "";
+
+    GameState::Handle GameState::GetHandle(const std::string &key)
+    {
+        auto found = this->handles.find(key);
+        if (found != this->handles.end())
+            return found->second;
+
+        Handle handle = this->entries.size();
+        this->entries.emplace_back();
+        this->entries.back().key = key;
+        this->handles[key] = handle;
+        return handle;
+    }
+
+    void GameState::Set(Handle handle, const std::string &value)
+    {
+        Entry &entry = this->entries[handle];
+        entry.value = value;
+        entry.numeric = ParseNumber(value, entry.number);
+        entry.set = true;
+
+        Signals::Publish(SignalGameState);
+    }
+
+    const std::string &GameState::Get(const std::string &key) const
+    {
+        auto found = this->handles.find(key);
+        return found != this->handles.end() ? this->entries[found->second].value : emptyValue;
+    }
+
+    void GameState::Clear()
+    {
+        for (auto &entry : this->entries)
+        {
+            entry.value.clear();
+            entry.number = 0;
+            entry.numeric = false;
+            entry.set = false;
+        }
+
+        Signals::Publish(SignalGameState);
+    }
+
+    std::map<std::string, std::string> GameState::ToMap() const
+    {
+        std::map<std::string, std::string> values;
+
+        for (auto &entry : this->entries)
+        {
+            if (entry.set)
+                values[entry.key] = entry.value;
+        }
+
+        return values;
+    }
+
+    bool GameState::ParseNumber(const std::string &value, int &number)
+    {
+        const char *start = value.c_str();
+        char *end = nullptr;
+
+        errno = 0;
+        long parsed = std::strtol(start, &end, 10);
+
+        if (end == start || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX)
+        {
+            number = 0;
+            return false;
+        }
+
+        number = (int)parsed;
+        return true;
+    }
+}
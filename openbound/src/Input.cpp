@@ -8,6 +8,7 @@ namespace SBURB
     InputHandler::InputHandler()
     {
         this->mouseDown = false;
+        this->mousePosition = {0, 0};
         this->pressed = {};
         this->pressedOrder = {};
 
@@ -50,19 +51,28 @@ namespace SBURB
     {
         if (!focused) return;
 
-        if (e.type == sf::Event::MouseButtonPressed) {
+        // NOTE: Track the position from events rather than asking the OS, so replays see the same mouse.
+        if (e.type == sf::Event::MouseMoved) {
+            inputHandlerInst->mousePosition = {e.mouseMove.x, e.mouseMove.y};
+        } else if (e.type == sf::Event::MouseButtonPressed) {
+            inputHandlerInst->mousePosition = {e.mouseButton.x, e.mouseButton.y};
             if (e.mouseButton.button == sf::Mouse::Left) {
                 inputHandlerInst->OnMouseDown();
             }
+            Signals::Publish(SignalInput);
         } else if (e.type == sf::Event::MouseButtonReleased) {
+            inputHandlerInst->mousePosition = {e.mouseButton.x, e.mouseButton.y};
             if (e.mouseButton.button == sf::Mouse::Left) {
                 inputHandlerInst->OnMouseUp();
             }
+            Signals::Publish(SignalInput);
         } else if (e.type == sf::Event::KeyPressed) {
             inputHandlerInst->OnKeyDown(e.key.code);
+            Signals::Publish(SignalInput);
         }
         else if (e.type == sf::Event::KeyReleased) {
             inputHandlerInst->OnKeyUp(e.key.code);
+            Signals::Publish(SignalInput);
         }
     }
 
@@ -149,7 +159,7 @@ namespace SBURB
     }
 
     sf::Vector2i InputHandler::GetMousePosition() {
-        return sf::Mouse::getPosition();
+        return inputHandlerInst->mousePosition;
     }
 
     bool InputHandler::GetMouseDown()
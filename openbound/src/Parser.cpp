@@ -257,13 +257,13 @@ namespace SBURB
 		if (tmpColSize)
 			colSize = tmpColSize;
 		else if (sheet)
-			colSize = round(sheet->GetAsset()->getSize().x / length);
+			colSize = round(sheet->GetSize().x / length);
 
 		int tmpRowSize = node.attribute("rowSize").as_int();
 		if (tmpRowSize)
 			rowSize = tmpRowSize;
 		else if (sheet)
-			rowSize = sheet->GetAsset()->getSize().y;
+			rowSize = sheet->GetSize().y;
 
 		int startPos = node.attribute("startPos").as_int();
 
@@ -416,33 +416,43 @@ namespace SBURB
 			newRoom->SetMapScale(mapScale);
 		}
 
+		pugi::xml_attribute walkMaskScale = node.attribute("walkMaskScale");
+		if (walkMaskScale)
+		{
+			newRoom->SetWalkMaskScale(walkMaskScale.as_int());
+		}
+
 		std::string walkableMap = node.attribute("walkableMap").as_string();
 		if (walkableMap != "")
 		{
 			newRoom->SetWalkableMap(AssetManager::GetGraphicByName(walkableMap));
 			if (!newRoom->GetWidth())
 			{
-				newRoom->SetWidth(newRoom->GetWalkableMap()->GetAsset()->getSize().x * newRoom->GetMapScale());
+				newRoom->SetWidth(newRoom->GetWalkableMap()->GetSize().x * newRoom->GetMapScale());
 			}
 
 			if (!newRoom->GetHeight())
 			{
-				newRoom->SetHeight(newRoom->GetWalkableMap()->GetAsset()->getSize().y * newRoom->GetMapScale());
+				newRoom->SetHeight(newRoom->GetWalkableMap()->GetSize().y * newRoom->GetMapScale());
 			}
 		}
 
-		Serializer::SerialLoadRoomSprites(newRoom, GetNestedChildren(&node, "sprite"));
-		Serializer::SerialLoadRoomSprites(newRoom, GetNestedChildren(&node, "character"));
-		Serializer::SerialLoadRoomSprites(newRoom, GetNestedChildren(&node, "fighter"));
+		std::vector<std::vector<pugi::xml_node>> roomSprites;
+		GetNestedChildren(node, {"sprite", "character", "fighter"}, roomSprites);
+
+		for (auto& sprites : roomSprites)
+		{
+			Serializer::SerialLoadRoomSprites(newRoom, sprites);
+		}
 
 		auto paths = node.child("paths");
-		if (!paths)
+		if (paths)
 		{
 			Serializer::SerialLoadRoomPaths(newRoom, paths);
 		}
 
 		auto triggers = node.child("triggers");
-		if (!triggers)
+		if (triggers)
 		{
 			Serializer::SerialLoadRoomTriggers(newRoom, triggers);
 		}
@@ -500,8 +510,8 @@ namespace SBURB
 		auto newButton = std::make_shared<SpriteButton>(node.attribute("name").as_string(),
 											  node.attribute("x").as_int(),
 											  node.attribute("y").as_int(),
-											  node.attribute("width").as_int(sheet->GetAsset()->getSize().x),
-											  node.attribute("height").as_int(sheet->GetAsset()->getSize().y),
+											  node.attribute("width").as_int(sheet->GetSize().x),
+											  node.attribute("height").as_int(sheet->GetSize().y),
 											  node.attribute("sheet").as_string(),
 											  nullptr);
 
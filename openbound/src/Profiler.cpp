@@ -0,0 +1,171 @@
+#include "Profiler.h"
+#include "AssetManager.h"
+#include "Logger.h"
+
+#include <SFML/Graphics.hpp>
+#include <fstream>
+#include <cstring>
+
+// Roughly a minute of samples at 30 ticks a second on a busy room
+constexpr size_t MAX_TRACE_SAMPLES = 1 << 18;
+constexpr size_t MAX_COUNTER_SAMPLES = 1 << 14;
+constexpr float AVERAGE_WEIGHT = 0.1f;
+
+namespace SBURB
+{
+    static const char *counterNames[Profiler::CounterCount] = {"drawCalls", "vertices", "triggerEvaluations"};
+
+    Profiler::Profiler()
+        : showOverlay(false), depth(0), frameStart(0), averageFrameTime(0),
+          nextSample(0), nextCounterSample(0)
+    {
+        std::fill(std::begin(this->frameCounters), std::end(this->frameCounters), 0);
+        std::fill(std::begin(this->lastCounters), std::end(this->lastCounters), 0);
+    }
+
+    void Profiler::SetEnabled(bool enabled)
+    {
+        if (enabled && this->samples.empty())
+        {
+            this->samples.resize(MAX_TRACE_SAMPLES);
+            this->counterSamples.resize(MAX_COUNTER_SAMPLES);
+        }
+
+        Profiler::enabled = enabled;
+        this->depth = 0;
+        this->frameStart = this->Now();
+    }
+
+    void Profiler::BeginFrame()
+    {
+        if (!enabled)
+            return;
+
+        this->frameStart = this->Now();
+    }
+
+    void Profiler::EndFrame()
+    {
+        if (!enabled)
+            return;
+
+        sf::Int64 frameTime = this->Now() - this->frameStart;
+        this->averageFrameTime += (frameTime - this->averageFrameTime) * AVERAGE_WEIGHT;
+
+        for (auto &phase : this->phases)
+        {
+            phase.average += (phase.frameTime - phase.average) * AVERAGE_WEIGHT;
+            phase.frameTime = 0;
+        }
+
+        CounterSample &sample = this->counterSamples[this->nextCounterSample % MAX_COUNTER_SAMPLES];
+        sample.time = this->frameStart;
+        for (int i = 0; i < CounterCount; i++)
+        {
+            sample.values[i] = this->frameCounters[i];
+            this->lastCounters[i] = this->frameCounters[i];
+            this->frameCounters[i] = 0;
+        }
+        this->nextCounterSample++;
+    }
+
+    void Profiler::AddSample(const char *name, sf::Int64 start, sf::Int64 end, int depth)
+    {
+        Sample &sample = this->samples[this->nextSample % MAX_TRACE_SAMPLES];
+        sample.name = name;
+        sample.start = start;
+        sample.duration = end - start;
+        sample.depth = depth;
+        this->nextSample++;
+
+        for (auto &phase : this->phases)
+        {
+            if (phase.name == name || strcmp(phase.name, name) == 0)
+            {
+                phase.frameTime += end - start;
+                return;
+            }
+        }
+
+        this->phases.push_back({name, depth, end - start, 0});
+    }
+
+    void Profiler::DrawOverlay(sf::RenderTarget &target)
+    {
+        if (!enabled || !this->showOverlay)
+            return;
+
+        std::ostringstream text;
+        text.setf(std::ios::fixed);
+        text.precision(2);
+        text << "frame " << this->averageFrameTime / 1000.0f << "ms\n";
+
+        for (auto &phase : this->phases)
+        {
+            text << std::string(phase.depth * 2, ' ') << phase.name << " " << phase.average / 1000.0f << "ms\n";
+        }
+
+        for (int i = 0; i < CounterCount; i++)
+        {
+            text << counterNames[i] << " " << this->lastCounters[i] << "\n";
+        }
+
+        sf::View oldView = target.getView();
+        target.setView(target.getDefaultView());
+
+        sf::RectangleShape background(sf::Vector2f(220, 14.0f * (this->phases.size() + CounterCount + 1) + 8));
+        background.setPosition(4, 4);
+        background.setFillColor(sf::Color(0, 0, 0, 180));
+        target.draw(background);
+
+        auto font = AssetManager::GetFontByName("SburbFont");
+        if (font && font->GetAsset())
+        {
+            sf::Text overlay(text.str(), *font->GetAsset(), 11);
+            overlay.setPosition(8, 8);
+            overlay.setFillColor(sf::Color::White);
+            target.draw(overlay);
+        }
+
+        target.setView(oldView);
+    }
+
+    bool Profiler::ExportTrace(std::string path)
+    {
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+        {
+            GlobalLogger->Log(Logger::Error, "Failed to open trace file " + path + ".");
+            return false;
+        }
+
+        // Chrome trace event format, load it in chrome://tracing or ui.perfetto.dev
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        size_t sampleCount = std::min(this->nextSample, MAX_TRACE_SAMPLES);
+        for (size_t i = this->nextSample - sampleCount; i < this->nextSample; i++)
+        {
+            const Sample &sample = this->samples[i % MAX_TRACE_SAMPLES];
+            file << (first ? "" : ",") << "\n{\"name\":\"" << sample.name << "\",\"cat\":\"sburb\",\"ph\":\"X\",\"ts\":" << sample.start << ",\"dur\":" << sample.duration << ",\"pid\":1,\"tid\":1}";
+            first = false;
+        }
+
+        size_t counterCount = std::min(this->nextCounterSample, MAX_COUNTER_SAMPLES);
+        for (size_t i = this->nextCounterSample - counterCount; i < this->nextCounterSample; i++)
+        {
+            const CounterSample &sample = this->counterSamples[i % MAX_COUNTER_SAMPLES];
+            file << (first ? "" : ",") << "\n{\"name\":\"counters\",\"ph\":\"C\",\"ts\":" << sample.time << ",\"pid\":1,\"args\":{";
+            for (int j = 0; j < CounterCount; j++)
+            {
+                file << (j ? "," : "") << "\"" << counterNames[j] << "\":" << sample.values[j];
+            }
+            file << "}}";
+            first = false;
+        }
+
+        file << "\n]}\n";
+        GlobalLogger->Log(Logger::Info, "Wrote trace to " + path + ".");
+        return true;
+    }
+}
@@ -0,0 +1,204 @@
+#include "Replay.h"
+#include "Logger.h"
+
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+
+// Log format, one event per line:
+//   <tick> key <down|up> <code>
+//   <tick> mouse <down|up|move> <button> <x> <y>
+//   end <tick>
+
+namespace SBURB
+{
+    Replay::Replay()
+    {
+        this->playing = false;
+        this->length = 0;
+        this->events = {};
+    }
+
+    Replay::~Replay()
+    {
+        if (this->recordFile.is_open())
+            this->recordFile.close();
+
+        if (this->hashFile.is_open())
+            this->hashFile.close();
+    }
+
+    bool Replay::StartRecording(std::string path)
+    {
+        this->recordFile.open(path, std::ios::out | std::ios::trunc);
+        if (!this->recordFile.is_open())
+        {
+            GlobalLogger->Log(Logger::Error, "Failed to open input log " + path + " for recording.");
+            return false;
+        }
+
+        this->recordFile << "# openbound input log v1\n";
+        return true;
+    }
+
+    bool Replay::LoadRecording(std::string path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            GlobalLogger->Log(Logger::Error, "Failed to open input log " + path + ".");
+            return false;
+        }
+
+        this->events = {};
+        this->length = 0;
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream stream(line);
+            std::string first;
+            stream >> first;
+
+            if (first == "end")
+            {
+                stream >> this->length;
+                continue;
+            }
+
+            // A corrupt log is skipped line by line rather than throwing out of here
+            char *end = nullptr;
+            unsigned long tick = std::strtoul(first.c_str(), &end, 10);
+            if (first.empty() || !isdigit((unsigned char)first[0]) || *end != '\0')
+            {
+                GlobalLogger->Log(Logger::Warning, "Skipping malformed input log line: " + line);
+                continue;
+            }
+
+            ReplayEvent replayEvent;
+            replayEvent.tick = tick;
+
+            std::string device, action;
+            stream >> device >> action;
+
+            if (device == "key")
+            {
+                int code;
+                if (!(stream >> code))
+                {
+                    GlobalLogger->Log(Logger::Warning, "Skipping malformed input log line: " + line);
+                    continue;
+                }
+
+                replayEvent.event.type = action == "down" ? sf::Event::KeyPressed : sf::Event::KeyReleased;
+                replayEvent.event.key.code = (sf::Keyboard::Key)code;
+                replayEvent.event.key.alt = false;
+                replayEvent.event.key.control = false;
+                replayEvent.event.key.shift = false;
+                replayEvent.event.key.system = false;
+            }
+            else if (device == "mouse")
+            {
+                int button, x, y;
+                if (!(stream >> button >> x >> y))
+                {
+                    GlobalLogger->Log(Logger::Warning, "Skipping malformed input log line: " + line);
+                    continue;
+                }
+
+                if (action == "move")
+                {
+                    replayEvent.event.type = sf::Event::MouseMoved;
+                    replayEvent.event.mouseMove.x = x;
+                    replayEvent.event.mouseMove.y = y;
+                }
+                else
+                {
+                    replayEvent.event.type = action == "down" ? sf::Event::MouseButtonPressed : sf::Event::MouseButtonReleased;
+                    replayEvent.event.mouseButton.button = (sf::Mouse::Button)button;
+                    replayEvent.event.mouseButton.x = x;
+                    replayEvent.event.mouseButton.y = y;
+                }
+            }
+            else
+            {
+                GlobalLogger->Log(Logger::Warning, "Skipping malformed input log line: " + line);
+                continue;
+            }
+
+            this->length = std::max(this->length, replayEvent.tick + 1);
+            this->events.push_back(replayEvent);
+        }
+
+        this->playing = true;
+        return true;
+    }
+
+    bool Replay::OpenHashLog(std::string path)
+    {
+        this->hashFile.open(path, std::ios::out | std::ios::trunc);
+        if (!this->hashFile.is_open())
+        {
+            GlobalLogger->Log(Logger::Error, "Failed to open state hash log " + path + ".");
+            return false;
+        }
+
+        return true;
+    }
+
+    void Replay::Close(uint32_t tick)
+    {
+        if (this->recordFile.is_open())
+        {
+            this->recordFile << "end " << tick << "\n";
+            this->recordFile.close();
+        }
+
+        if (this->hashFile.is_open())
+            this->hashFile.close();
+    }
+
+    void Replay::RecordEvent(uint32_t tick, const sf::Event &event)
+    {
+        if (!this->recordFile.is_open())
+            return;
+
+        switch (event.type)
+        {
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+            this->recordFile << tick << " key " << (event.type == sf::Event::KeyPressed ? "down " : "up ") << (int)event.key.code << "\n";
+            break;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            this->recordFile << tick << " mouse " << (event.type == sf::Event::MouseButtonPressed ? "down " : "up ") << (int)event.mouseButton.button << " " << event.mouseButton.x << " " << event.mouseButton.y << "\n";
+            break;
+        case sf::Event::MouseMoved:
+            this->recordFile << tick << " mouse move 0 " << event.mouseMove.x << " " << event.mouseMove.y << "\n";
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool Replay::PollEvent(uint32_t tick, sf::Event &event)
+    {
+        if (this->events.empty() || this->events.front().tick > tick)
+            return false;
+
+        event = this->events.front().event;
+        this->events.pop_front();
+        return true;
+    }
+
+    void Replay::WriteStateHash(uint32_t tick, uint64_t hash)
+    {
+        if (!this->hashFile.is_open())
+            return;
+
+        this->hashFile << tick << " " << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << "\n";
+    }
+}
@@ -1,10 +1,12 @@
 #include "Room.h"
+#include "BatchHandler.h"
 
 constexpr int BLOCK_SIZE = 500;
+constexpr int DEFAULT_WALK_MASK_SCALE = 4;
 
 namespace SBURB
 {
-    Room::Room(std::string name, int width, int height) {
+    Room::Room(std::string name, int width, int height) : grid(width, height) {
 		this->name = name;
 		this->width = width;
 		this->height = height;
@@ -17,10 +19,17 @@ namespace SBURB
 		this->walkableMap = nullptr;
 		this->mapData = nullptr;
 		this->mapScale = 4;
+		this->walkMaskScale = DEFAULT_WALK_MASK_SCALE;
+		this->walkMaskDirty = true;
+		this->staticCount = 0;
+		this->staticSignature = 0;
+		this->triggerSignals = SignalNone;
+		this->triggersCheckedAt = 0;
+		this->triggersDirty = true;
     }
 
 	Room::~Room() {
-
+		BatchHandler::getInstance().InvalidateStatic(this);
 	}
 
 	void Room::AddEffect(std::shared_ptr<Animation> effect) {
@@ -29,15 +38,23 @@ namespace SBURB
 
 	void Room::AddTrigger(std::shared_ptr<Trigger> trigger) {
 		this->triggers.push_back(trigger);
+		this->triggerSignals |= trigger->GetSignals();
+		this->triggersDirty = true;
 	}
 
 	void Room::AddSprite(std::shared_ptr<Sprite> sprite) {
 		if (!this->Contains(sprite)) {
 			this->sprites.push_back(sprite);
+			this->grid.Insert(sprite);
+			this->grid.SetOrder(sprite.get(), this->sprites.size() - 1);
 		}
 	}
 
 	bool Room::RemoveSprite(std::shared_ptr<Sprite> sprite) {
+		if (!this->grid.Remove(sprite.get())) {
+			return false;
+		}
+
 		for (int i = 0; i < this->sprites.size(); i++) {
 			if (this->sprites[i] == sprite) {
 				this->sprites.erase(this->sprites.begin() + i);
@@ -50,18 +67,22 @@ namespace SBURB
 
 	void Room::AddWalkable(std::shared_ptr<AssetPath> path) {
 		this->walkables.push_back(path);
+		this->walkMaskDirty = true;
 	}
 
 	void Room::RemoveWalkable(std::shared_ptr<AssetPath> path) {
 		this->walkables.erase(std::find(this->walkables.begin(), this->walkables.end(), path));
+		this->walkMaskDirty = true;
 	}
 	
 	void Room::AddUnwalkable(std::shared_ptr<AssetPath> path) {
 		this->unwalkables.push_back(path);
+		this->walkMaskDirty = true;
 	}
 
 	void Room::RemoveUnwalkable(std::shared_ptr<AssetPath> path) {
 		this->unwalkables.erase(std::find(this->unwalkables.begin(), this->unwalkables.end(), path));
+		this->walkMaskDirty = true;
 	}
 
 	void Room::AddMotionPath(std::shared_ptr<AssetPath> path, int xtox, int xtoy, int ytox, int ytoy, int dx, int dy) {
@@ -71,25 +92,72 @@ namespace SBURB
 	}
 
 	void Room::Enter() {
-		if (this->walkableMap) {
-			sf::Image img = this->walkableMap->GetAsset()->copyToImage();
-			this->mapData = std::make_shared<sf::Image>(img);
+		this->triggersDirty = true;
+
+		for (auto trigger : this->triggers) {
+			trigger->Resume();
+		}
+
+		if (this->walkMaskDirty) {
+			this->BakeWalkMask();
 		}
 	}
 
 	void Room::Exit() {
+		// Timed triggers only count down while we're here
+		for (auto trigger : this->triggers) {
+			trigger->Pause();
+		}
+
 		this->effects.clear();
-		this->mapData = nullptr;
+		this->pathWalk.Release();
+		this->pathBlock.Release();
+		this->pathEdge.Release();
+		this->walkMaskDirty = true;
+		BatchHandler::getInstance().InvalidateStatic(this);
+		this->staticSignature = 0;
 	}
 
-	bool Room::Contains(std::shared_ptr<Sprite> sprite) {
-		for (int i = 0; i < this->sprites.size(); i++) {
-			if (this->sprites[i].get() == sprite.get()) {
-				return true;
+	void Room::CollectAssets(std::vector<std::shared_ptr<Asset>>& assets) {
+		for (auto sprite : this->sprites) {
+			for (auto animation : sprite->GetAnimations()) {
+				if (animation.second) {
+					animation.second->CollectSheets(assets);
+				}
 			}
 		}
 
-		return false;
+		for (auto effect : this->effects) {
+			effect->CollectSheets(assets);
+		}
+	}
+
+	void Room::CollectNeighbours(std::vector<std::string>& rooms) {
+		auto follow = [&rooms](std::shared_ptr<Action> action) {
+			for (; action; action = action->GetFollowUp()) {
+				std::string command = action->GetCommand();
+				if (command == "changeRoom" || command == "teleport") {
+					const std::string &room = action->GetArgs().Get(0);
+					if (std::find(rooms.begin(), rooms.end(), room) == rooms.end()) {
+						rooms.push_back(room);
+					}
+				}
+			}
+		};
+
+		for (auto sprite : this->sprites) {
+			for (auto action : sprite->GetAllActions()) {
+				follow(action);
+			}
+		}
+
+		for (auto trigger : this->triggers) {
+			follow(trigger->GetAction());
+		}
+	}
+
+	bool Room::Contains(std::shared_ptr<Sprite> sprite) {
+		return this->grid.Contains(sprite.get());
 	}
 
 	void Room::Update() {
@@ -106,21 +174,78 @@ namespace SBURB
 			}
 		}
 
-		for (int i = this->triggers.size() - 1; i >= 0; i--) {
-			if (this->triggers[i]->TryToTrigger()) {
-				this->triggers.erase(this->triggers.begin() + i);
+		// Nothing any trigger here listens to happened, none of them can have changed their mind
+		if (this->triggersDirty || Signals::Since(this->triggerSignals, this->triggersCheckedAt)) {
+			this->triggersCheckedAt = Signals::Now();
+			this->triggersDirty = false;
+
+			for (int i = this->triggers.size() - 1; i >= 0; i--) {
+				if (this->triggers[i]->TryToTrigger()) {
+					this->triggers.erase(this->triggers.begin() + i);
+				}
+				else if (this->triggers[i]->IsDirty()) {
+					this->triggersDirty = true;
+				}
 			}
 		}
 
 		this->SortDepths(); // Moved here from draw due to const issue. If issues occur, refer to source code.
+		for (int i = 0; i < this->sprites.size(); i++) {
+			this->grid.SetOrder(this->sprites[i].get(), i);
+		}
+		this->UpdateStaticLayer();
+	}
+
+	void Room::UpdateStaticLayer() {
+		size_t count = 0;
+		size_t signature = 0;
+
+		while (count < this->sprites.size() && this->sprites[count]->IsStatic()) {
+			Sprite* sprite = this->sprites[count].get();
+			signature = signature * 31 + std::hash<Sprite*>()(sprite);
+			signature = signature * 31 + std::hash<Animation*>()(sprite->GetAnimation().get());
+			signature = signature * 31 + std::hash<int>()(sprite->GetX());
+			signature = signature * 31 + std::hash<int>()(sprite->GetY());
+			count++;
+		}
+
+		if (count != this->staticCount || signature != this->staticSignature) {
+			BatchHandler::getInstance().InvalidateStatic(this);
+			this->staticCount = count;
+			this->staticSignature = signature;
+		}
 	}
 
 	void Room::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-		for (int i = 0; i < this->sprites.size(); i++) {
+		size_t first = 0;
+
+		if (this->staticCount > 0 && this->staticCount <= this->sprites.size()) {
+			BatchHandler& batcher = BatchHandler::getInstance();
+
+			if (!batcher.DrawStatic(this, target)) {
+				batcher.BeginStatic(this);
+				for (size_t i = 0; i < this->staticCount; i++) {
+					target.draw(*this->sprites[i], states);
+				}
+				batcher.EndStatic(target);
+			}
+
+			first = this->staticCount;
+		}
+
+		const BatchHandler& batcher = BatchHandler::getInstance();
+
+		for (size_t i = first; i < this->sprites.size(); i++) {
+			if (batcher.IsCulled(states.transform.transformRect(this->sprites[i]->GetBounds())))
+				continue;
+
 			target.draw(*this->sprites[i], states);
 		}
 
 		for (int i = 0; i < this->effects.size(); i++) {
+			if (batcher.IsCulled(states.transform.transformRect(this->effects[i]->GetBounds())))
+				continue;
+
 			target.draw(*this->effects[i], states);
 		}
 	}
@@ -142,9 +267,10 @@ namespace SBURB
 	std::vector<std::shared_ptr<Action>> Room::QueryActions(std::shared_ptr<Sprite> query, int x, int y) {
 		std::vector<std::shared_ptr<Action>> validActions = {};
 
-		for (int i = 0; i < this->sprites.size(); i++) {
-			std::shared_ptr<Sprite> sprite = this->sprites[i];
-			
+		this->nearby.clear();
+		this->grid.Query(x, y, x, y, this->nearby);
+
+		for (const std::shared_ptr<Sprite>& sprite : this->nearby) {
 			if (sprite != query && sprite->HitsPoint(x, y)) {
 				std::vector<std::shared_ptr<Action>> actions = sprite->GetActions(query);
 				
@@ -158,8 +284,10 @@ namespace SBURB
 	std::vector<std::shared_ptr<Action>> Room::QueryActionsVisual(std::shared_ptr<Sprite> query, int x, int y) {
 		std::vector<std::shared_ptr<Action>> validActions = {};
 
-		for (int i = 0; i < this->sprites.size(); i++) {
-			std::shared_ptr<Sprite> sprite = this->sprites[i];
+		this->nearby.clear();
+		this->grid.Query(x, y, x, y, this->nearby);
+
+		for (const std::shared_ptr<Sprite>& sprite : this->nearby) {
 			if (sprite->IsVisuallyUnder(x, y)) {
 				std::vector<std::shared_ptr<Action>> actions = sprite->GetActions(query);
 
@@ -171,53 +299,136 @@ namespace SBURB
 	}
 
 	bool Room::IsInBounds(Sprite* sprite, int dx, int dy) {
-		std::map<std::string, Vector2> queries = sprite->GetBoundaryQueries(dx, dy);
-		std::map<std::string, bool> results;
-		this->IsInBoundsBatch(queries, &results);
+		BoundaryQuery query;
+		sprite->GetBoundaryQueries(query, dx, dy);
+		this->IsInBoundsBatch(query);
 
-		for (auto point : results) {
-			if (!point.second) {
-				return false;
-			}
-		}
-
-		return true;
+		return query.AllInBounds();
 	}
 
-	std::map<std::string, bool> Room::IsInBoundsBatch(std::map<std::string, Vector2> queries, std::map<std::string, bool>* results) {
+	void Room::IsInBoundsBatch(BoundaryQuery& query) {
+		bool hasPaths = !this->walkables.empty() || !this->unwalkables.empty();
+
+		// With nothing to walk on everything is in bounds
+		for (int i = 0; i < query.count; i++) {
+			query.results[i] = !this->walkableMap && !hasPaths;
+		}
+
 		if (this->walkableMap) {
-			for (auto query : queries) {
-				Vector2 pt = query.second;
-				int width = this->walkableMap->GetAsset()->getSize().x;
-				int height = this->walkableMap->GetAsset()->getSize().y;
-				
-				if (pt.x<0 || pt.x>width * this->mapScale || pt.y<0 || pt.y>height * this->mapScale) {
-					(*results)[query.first] = false;
+			for (int i = 0; i < query.count; i++) {
+				int x = query.x[i];
+				int y = query.y[i];
+
+				if (x < 0 || y < 0 || !this->mapData) {
+					query.results[i] = false;
 				}
 				else {
-					int mapX = round(pt.x / this->mapScale);
-					int mapY = round(pt.y / this->mapScale);
+					int mapX = x / this->mapScale;
+					int mapY = y / this->mapScale;
 
-					(*results)[query.first] = this->mapData->getPixel(mapX, mapY) == sf::Color::White;
+					query.results[i] = this->mapData->Contains(mapX, mapY) && this->mapData->Get(mapX, mapY);
 				}
 			}
 		}
 
+		if (!hasPaths) {
+			return;
+		}
+
+		if (this->walkMaskDirty) {
+			this->BakeWalkMask();
+		}
+
+		// Inside the walkable map or any walkable path, and outside every unwalkable path.
+		// Points the mask can't settle are gathered up and run through the polygons together.
+		BoundaryQuery exact;
+		int slots[BoundaryQuery::MAX_POINTS];
+
+		for (int i = 0; i < query.count; i++) {
+			bool walk, block;
+			if (this->LookupWalkMask(query.x[i], query.y[i], walk, block)) {
+				query.results[i] = (query.results[i] || walk) && !block;
+			}
+			else {
+				slots[exact.count] = i;
+				exact.results[exact.count] = query.results[i];
+				exact.Push(query.x[i], query.y[i]);
+			}
+		}
+
+		if (exact.count == 0) {
+			return;
+		}
+
 		for (int i = 0; i < this->walkables.size(); i++) {
-			this->walkables[i]->QueryBatchPos(queries, results);
+			this->walkables[i]->QueryBatchPos(exact);
 		}
 
 		for (int i = 0; i < this->unwalkables.size(); i++) {
-			this->unwalkables[i]->QueryBatchNeg(queries, results);
+			this->unwalkables[i]->QueryBatchNeg(exact);
+		}
+
+		for (int i = 0; i < exact.count; i++) {
+			query.results[slots[i]] = exact.results[i];
+		}
+	}
+
+	bool Room::LookupWalkMask(int x, int y, bool& walk, bool& block) {
+		if (this->pathEdge.IsEmpty()) {
+			return false;
+		}
+
+		int col = (int)std::floor((float)x / this->walkMaskScale);
+		int row = (int)std::floor((float)y / this->walkMaskScale);
+
+		if (!this->pathEdge.Contains(col, row) || this->pathEdge.Get(col, row)) {
+			return false;
 		}
 
-		return *results;
+		walk = this->pathWalk.Get(col, row);
+		block = this->pathBlock.Get(col, row);
+		return true;
+	}
+
+	void Room::BakeWalkMask() {
+		this->walkMaskDirty = false;
+		this->pathWalk.Release();
+		this->pathBlock.Release();
+		this->pathEdge.Release();
+
+		if (this->walkMaskScale <= 0 || (this->walkables.empty() && this->unwalkables.empty())) {
+			return;
+		}
+
+		int cols = (this->width + this->walkMaskScale - 1) / this->walkMaskScale;
+		int rows = (this->height + this->walkMaskScale - 1) / this->walkMaskScale;
+		if (cols <= 0 || rows <= 0) {
+			return;
+		}
+
+		this->pathWalk.Resize(cols, rows);
+		this->pathBlock.Resize(cols, rows);
+		this->pathEdge.Resize(cols, rows);
+
+		for (int i = 0; i < this->walkables.size(); i++) {
+			this->walkables[i]->RasterizeInterior(this->pathWalk, this->walkMaskScale);
+			this->walkables[i]->RasterizeEdges(this->pathEdge, this->walkMaskScale);
+		}
+
+		for (int i = 0; i < this->unwalkables.size(); i++) {
+			this->unwalkables[i]->RasterizeInterior(this->pathBlock, this->walkMaskScale);
+			this->unwalkables[i]->RasterizeEdges(this->pathEdge, this->walkMaskScale);
+		}
 	}
 
 	std::shared_ptr<Sprite> Room::Collides(Sprite* sprite, int dx, int dy) {
-		for (int i = 0; i < this->sprites.size(); i++) {
-			std::shared_ptr<Sprite> curSprite = this->sprites[i];
-		
+		int x = sprite->GetX() + dx;
+		int y = sprite->GetY() + dy;
+
+		this->nearby.clear();
+		this->grid.Query(x - sprite->GetWidth() / 2, y - sprite->GetHeight() / 2, x + sprite->GetWidth() / 2, y + sprite->GetHeight() / 2, this->nearby);
+
+		for (const std::shared_ptr<Sprite>& curSprite : this->nearby) {
 			if (curSprite->GetCollidable() && sprite != curSprite.get()) {
 				if (sprite->Collides(curSprite, dx, dy)) {
 					return curSprite;
@@ -228,47 +439,46 @@ namespace SBURB
 		return nullptr;
 	}
 	
-	std::string Room::Serialize(std::string output) {
-		output = output + "\n<room name='" + this->name +
-			"' width='" + std::to_string(this->width) +
-			"' height='" + std::to_string(this->height) +
-			(this->walkableMap ? ("' walkableMap='" + this->walkableMap->GetName()) : "") +
-			(this->mapScale != 4 ? ("' mapScale='" + std::to_string(this->mapScale)) : "") +
-			"' >";
-
-		output = output + "\n<paths>";
-
-		for (int i = 0; i < this->walkables.size(); i++) {
-			std::shared_ptr<AssetPath> walkable = this->walkables[i];
-			output = output + "\n<walkable path='" + walkable->GetName() + "'/>";
+	void Room::Serialize(SerialWriter &out) {
+		out << "\n<room name='" << this->name <<
+			"' width='" << this->width <<
+			"' height='" << this->height;
+		if (this->walkableMap)
+			out << "' walkableMap='" << this->walkableMap->GetName();
+		if (this->mapScale != 4)
+			out << "' mapScale='" << this->mapScale;
+		if (this->walkMaskScale != DEFAULT_WALK_MASK_SCALE)
+			out << "' walkMaskScale='" << this->walkMaskScale;
+		out << "' >";
+
+		out << "\n<paths>";
+
+		for (const auto &walkable : this->walkables) {
+			out << "\n<walkable path='" << walkable->GetName() << "'/>";
 		}
 
-		for (int i = 0; i < this->unwalkables.size(); i++) {
-			std::shared_ptr<AssetPath> unwalkable = this->unwalkables[i];
-			output = output + "\n<unwalkable path='" + unwalkable->GetName() + "'/>";
+		for (const auto &unwalkable : this->unwalkables) {
+			out << "\n<unwalkable path='" << unwalkable->GetName() << "'/>";
 		}
 
-		for (int i = 0; i < this->motionPaths.size(); i++) {
-			std::shared_ptr<MotionPath> motionPath = this->motionPaths[i];
-			output = output + "\n<motionpath path='" + motionPath->path->GetName()  + "' xtox='" + std::to_string(motionPath->xtox) + "' xtoy='" + std::to_string(motionPath->xtoy) +
-				"' ytox='" + std::to_string(motionPath->ytox) + "' ytoy='" + std::to_string(motionPath->ytoy) + "' dx='" + std::to_string(motionPath->dx) + "' dy='" + std::to_string(motionPath->dy) + "'/>";
+		for (const auto &motionPath : this->motionPaths) {
+			out << "\n<motionpath path='" << motionPath->path->GetName() << "' xtox='" << motionPath->xtox << "' xtoy='" << motionPath->xtoy <<
+				"' ytox='" << motionPath->ytox << "' ytoy='" << motionPath->ytoy << "' dx='" << motionPath->dx << "' dy='" << motionPath->dy << "'/>";
 		}
 
-		output = output + "\n</paths>";
-		output = output + "\n<triggers>";
+		out << "\n</paths>";
+		out << "\n<triggers>";
 
-		for (int i = 0; i < this->triggers.size(); i++) {
-			output = this->triggers[i]->Serialize(output);
+		for (const auto &trigger : this->triggers) {
+			trigger->Serialize(out);
 		}
 
-		output = output + "\n</triggers>";
+		out << "\n</triggers>";
 
-		for (int i = 0; i < this->sprites.size(); i++) {
-			output = this->sprites[i]->Serialize(output);
+		for (const auto &sprite : this->sprites) {
+			sprite->Serialize(out);
 		}
 
-		output = output + "\n</room>";
-
-		return output;
+		out << "\n</room>";
 	}
 }
@@ -0,0 +1,588 @@
+#include "SaveStore.h"
+#include "Serializer.h"
+#include "Sburb.h"
+#include "Logger.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <zlib.h>
+
+constexpr char SAVE_MAGIC[4] = {'S', 'B', 'S', 'V'};
+constexpr const char *SAVE_EXTENSION = ".sbsv";
+// Descriptions are a character and a room name, anything near this is not a save
+constexpr uint32_t MAX_DESCRIPTION_LENGTH = 4096;
+
+namespace SBURB
+{
+    static std::string saveDirectory = "saves/";
+    // Session slots, manual then automatic. The save writer fills them too, so they go through the lock.
+    static std::string sessionSlots[2];
+    static std::mutex sessionMutex;
+
+    // Bumped by InvalidateBase, autosaves take a full serialization whenever the writer's is older
+    static uint32_t baseGeneration = 1;
+    static uint32_t queuedBaseGeneration = 0;
+
+    struct SpriteSnapshot
+    {
+        std::string name;
+        int x = 0;
+        int y = 0;
+        std::string state;
+        std::string facing;
+        // Empty for sprites outside every room
+        std::string room;
+    };
+
+    // Everything an autosave needs, taken on the game thread in one go so the rest can happen anywhere.
+    // Only the parts that change in play, unless the state was rearranged since the last full one.
+    struct SaveSnapshot
+    {
+        bool automatic = false;
+        bool local = false;
+        std::string path;
+        SaveStore::Header header;
+        // A full serialization for the writer to patch from now on, empty when its last one still holds
+        std::string base;
+        std::string root;
+        std::map<std::string, std::string> gameState;
+        std::vector<SpriteSnapshot> sprites;
+        std::string actionQueues;
+    };
+
+    static void SetAttribute(pugi::xml_node node, const char *name, const std::string &value)
+    {
+        pugi::xml_attribute attribute = node.attribute(name);
+        if (!attribute)
+            attribute = node.append_attribute(name);
+        attribute.set_value(value.c_str());
+    }
+
+    static bool WriteSlot(const SaveSnapshot &snapshot, const std::function<void(SerialWriter &)> &body);
+
+    // Compresses and writes snapshots off the game thread, those take far longer than taking the snapshot
+    class SaveWriter
+    {
+    public:
+        inline static SaveWriter &getInstance()
+        {
+            static SaveWriter instance;
+            return instance;
+        }
+
+        SaveWriter(SaveWriter const &) = delete;
+        void operator=(SaveWriter const &) = delete;
+
+        void Queue(SaveSnapshot snapshot)
+        {
+            if (!this->worker.joinable())
+                this->worker = std::thread(&SaveWriter::Work, this);
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+
+                // Only the newest state for a slot is worth writing
+                auto found = std::find_if(this->pending.begin(), this->pending.end(), [&](const SaveSnapshot &queued) {
+                    return queued.automatic == snapshot.automatic && queued.local == snapshot.local;
+                });
+
+                if (found != this->pending.end())
+                {
+                    // The newer snapshot patches whichever base came last, a skipped one still has to be taken in
+                    if (snapshot.base.empty())
+                        snapshot.base = std::move(found->base);
+                    *found = std::move(snapshot);
+                }
+                else
+                    this->pending.push_back(std::move(snapshot));
+            }
+            this->jobReady.notify_one();
+        }
+
+        // A queued or in flight snapshot for the slot, the file may not be there yet
+        bool FindHeader(bool automatic, bool local, SaveStore::Header &header)
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            for (auto it = this->pending.rbegin(); it != this->pending.rend(); it++)
+            {
+                if (it->automatic == automatic && it->local == local)
+                {
+                    header = it->header;
+                    return true;
+                }
+            }
+
+            if (this->busy && this->current.automatic == automatic && this->current.local == local)
+            {
+                header = this->current.header;
+                return true;
+            }
+
+            return false;
+        }
+
+        // Blocks until everything queued so far is written
+        void Finish()
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->jobDone.wait(lock, [this] { return this->pending.empty() && !this->busy; });
+        }
+
+    private:
+        SaveWriter() : busy(false), stopping(false) {}
+
+        ~SaveWriter()
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->stopping = true;
+            }
+            this->jobReady.notify_all();
+
+            // Pending saves still get written, the worker only stops once it runs dry
+            if (this->worker.joinable())
+                this->worker.join();
+        }
+
+        void Work()
+        {
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(this->mutex);
+                    this->jobReady.wait(lock, [this] { return this->stopping || !this->pending.empty(); });
+
+                    if (this->pending.empty())
+                        return;
+
+                    this->current = std::move(this->pending.front());
+                    this->pending.pop_front();
+                    this->busy = true;
+                }
+
+                if (this->Patch(this->current))
+                {
+                    WriteSlot(this->current, [this](SerialWriter &out) {
+                        SerialXMLWriter writer(out);
+                        this->base.print(writer, "", pugi::format_raw);
+                    });
+                }
+                else
+                {
+                    GlobalLogger->Log(Logger::Error, "Autosave skipped, there is no full state to patch it into.");
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    this->busy = false;
+                    this->current = SaveSnapshot();
+                }
+                this->jobDone.notify_all();
+            }
+        }
+
+        // Takes in a new base if the snapshot brought one and writes the snapshot's parts over it
+        bool Patch(const SaveSnapshot &snapshot)
+        {
+            if (!snapshot.base.empty())
+                this->SetBase(snapshot.base);
+
+            pugi::xml_node root = this->base.child("sburb");
+            if (!root)
+                return false;
+
+            pugi::xml_document rootDoc;
+            rootDoc.load_string((snapshot.root + "</sburb>").c_str());
+            while (root.first_attribute())
+                root.remove_attribute(root.first_attribute());
+            for (pugi::xml_attribute attribute : rootDoc.child("sburb").attributes())
+                root.append_copy(attribute);
+
+            for (const SpriteSnapshot &sprite : snapshot.sprites)
+            {
+                auto found = this->baseSprites.find(sprite.name);
+                if (found == this->baseSprites.end())
+                    continue;
+
+                pugi::xml_node node = found->second;
+                SetAttribute(node, "x", std::to_string(sprite.x));
+                SetAttribute(node, "y", std::to_string(sprite.y));
+                // Sprites with a single animation leave the state out, they can't be in another one
+                if (node.attribute("state"))
+                    SetAttribute(node, "state", sprite.state);
+                if (node.attribute("facing"))
+                    SetAttribute(node, "facing", sprite.facing);
+
+                pugi::xml_node parent = root;
+                auto room = this->baseRooms.find(sprite.room);
+                if (room != this->baseRooms.end())
+                    parent = room->second;
+
+                // Loose sprites go back ahead of the rooms, where the serializer puts them
+                if (node.parent() != parent)
+                {
+                    pugi::xml_node rooms = root.child("rooms");
+                    if (parent == root && rooms)
+                        root.insert_move_before(node, rooms);
+                    else
+                        parent.append_move(node);
+                }
+            }
+
+            pugi::xml_node gameStateNode = root.child("gameState");
+            if (!gameStateNode)
+                gameStateNode = root.append_child("gameState");
+            gameStateNode.remove_children();
+            for (const auto &state : snapshot.gameState)
+                gameStateNode.append_child(state.first.c_str()).text().set(state.second.c_str());
+
+            pugi::xml_document queuesDoc;
+            queuesDoc.load_string(snapshot.actionQueues.c_str());
+            root.remove_child("actionQueues");
+            root.append_copy(queuesDoc.child("actionQueues"));
+
+            return true;
+        }
+
+        void SetBase(const std::string &state)
+        {
+            this->baseSprites.clear();
+            this->baseRooms.clear();
+
+            pugi::xml_parse_result result = this->base.load_buffer(state.data(), state.size());
+            if (result.status != pugi::status_ok)
+            {
+                GlobalLogger->Log(Logger::Error, std::string("Failed to parse the state for autosaves: ") + result.description());
+                this->base.reset();
+                return;
+            }
+
+            // Sprites sit loose in the root or in their rooms, after the paths and triggers
+            pugi::xml_node root = this->base.child("sburb");
+            for (pugi::xml_node node : root.children())
+            {
+                std::string tag = node.name();
+                if (tag == "sprite" || tag == "character" || tag == "fighter")
+                    this->baseSprites.emplace(node.attribute("name").as_string(), node);
+            }
+
+            for (pugi::xml_node room : root.child("rooms").children("room"))
+            {
+                this->baseRooms.emplace(room.attribute("name").as_string(), room);
+                for (pugi::xml_node node : room.children())
+                {
+                    std::string tag = node.name();
+                    if (tag != "paths" && tag != "triggers")
+                        this->baseSprites.emplace(node.attribute("name").as_string(), node);
+                }
+            }
+        }
+
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable jobReady;
+        std::condition_variable jobDone;
+        std::deque<SaveSnapshot> pending;
+        SaveSnapshot current;
+        // Only the worker touches these
+        pugi::xml_document base;
+        std::unordered_map<std::string, pugi::xml_node> baseSprites;
+        std::unordered_map<std::string, pugi::xml_node> baseRooms;
+        bool busy;
+        bool stopping;
+    };
+
+    static void Put32(SerialWriter &out, uint32_t value)
+    {
+        char bytes[4] = {(char)(value & 0xFF), (char)(value >> 8 & 0xFF), (char)(value >> 16 & 0xFF), (char)(value >> 24 & 0xFF)};
+        out.Write(bytes, 4);
+    }
+
+    static bool Get32(std::istream &in, uint32_t &value)
+    {
+        unsigned char bytes[4];
+        if (!in.read((char *)bytes, 4))
+            return false;
+
+        value = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+        return true;
+    }
+
+    static bool ReadHeader(std::istream &in, SaveStore::Header &header)
+    {
+        char magic[4];
+        if (!in.read(magic, 4) || !std::equal(SAVE_MAGIC, SAVE_MAGIC + 4, magic))
+            return false;
+
+        uint32_t version, timestampLow, timestampHigh, descriptionLength;
+        if (!Get32(in, version) || version != SaveStore::VERSION)
+            return false;
+
+        if (!Get32(in, timestampLow) || !Get32(in, timestampHigh) || !Get32(in, descriptionLength) || descriptionLength > MAX_DESCRIPTION_LENGTH)
+            return false;
+
+        header.timestamp = (int64_t)((uint64_t)timestampHigh << 32 | timestampLow);
+        header.description.resize(descriptionLength);
+        return (bool)in.read(header.description.data(), descriptionLength);
+    }
+
+    // Inflates whatever follows the header
+    static bool ReadBody(std::istream &in, std::string &state)
+    {
+        z_stream stream = {};
+        if (inflateInit(&stream) != Z_OK)
+            return false;
+
+        char input[16 * 1024];
+        char output[64 * 1024];
+        int result = Z_OK;
+
+        while (result != Z_STREAM_END)
+        {
+            in.read(input, sizeof(input));
+            if (in.gcount() == 0)
+                break;
+
+            stream.next_in = (Bytef *)input;
+            stream.avail_in = in.gcount();
+
+            do
+            {
+                stream.next_out = (Bytef *)output;
+                stream.avail_out = sizeof(output);
+
+                result = inflate(&stream, Z_NO_FLUSH);
+                if (result != Z_OK && result != Z_STREAM_END)
+                {
+                    inflateEnd(&stream);
+                    return false;
+                }
+
+                state.append(output, sizeof(output) - stream.avail_out);
+            } while (stream.avail_out == 0 && result != Z_STREAM_END);
+        }
+
+        inflateEnd(&stream);
+        return result == Z_STREAM_END;
+    }
+
+    static std::unique_ptr<std::istream> OpenSlot(bool automatic, bool local)
+    {
+        if (!local)
+        {
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            if (sessionSlots[automatic].empty())
+                return nullptr;
+            return std::make_unique<std::istringstream>(sessionSlots[automatic]);
+        }
+
+        auto file = std::make_unique<std::ifstream>(SaveStore::GetSlotPath(automatic), std::ios::binary);
+        if (!file->is_open())
+            return nullptr;
+        return file;
+    }
+
+    bool SaveStore::Write(SerialWriter &out, const Header &header, const std::function<void(SerialWriter &)> &body)
+    {
+        uint64_t timestamp = header.timestamp;
+
+        out.Write(SAVE_MAGIC, 4);
+        Put32(out, VERSION);
+        Put32(out, timestamp & 0xFFFFFFFF);
+        Put32(out, timestamp >> 32);
+        Put32(out, header.description.size());
+        out << header.description;
+
+        DeflateSerialWriter deflate(out);
+        body(deflate);
+        return deflate.Finish();
+    }
+
+    // Local slots go to a temporary file first and are renamed over the old save, so a crash
+    // halfway through leaves the previous save intact instead of half of a new one
+    static bool WriteSlot(const SaveSnapshot &snapshot, const std::function<void(SerialWriter &)> &body)
+    {
+        if (!snapshot.local)
+        {
+            StringSerialWriter out;
+            if (!SaveStore::Write(out, snapshot.header, body))
+                return false;
+
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            sessionSlots[snapshot.automatic] = std::move(out.GetString());
+            return true;
+        }
+
+        std::string temporaryPath = snapshot.path + ".tmp";
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(snapshot.path).parent_path(), error);
+
+        bool written;
+        {
+            FileSerialWriter out(temporaryPath);
+            written = out.IsOpen() && SaveStore::Write(out, snapshot.header, body) && out.Close();
+        }
+
+        if (written)
+            std::filesystem::rename(temporaryPath, snapshot.path, error);
+
+        if (!written || error)
+        {
+            GlobalLogger->Log(Logger::Error, "Failed to write save " + snapshot.path + ".");
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SaveStore::Save(const std::string &description, bool automatic, bool local)
+    {
+        SaveSnapshot snapshot;
+        snapshot.automatic = automatic;
+        snapshot.local = local;
+        snapshot.path = GetSlotPath(automatic);
+        snapshot.header.description = description;
+        snapshot.header.timestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+        // The player asked for this one and expects it to be there right after
+        if (!automatic)
+            return WriteSlot(snapshot, [](SerialWriter &out) { Serializer::Serialize(out); });
+
+        // Autosaves happen mid game, only what play changes is copied here. Serializing the rest, compressing
+        // and the disk are left to the writer, which keeps the last full serialization to patch.
+        {
+            SBURB_PROFILE_SCOPE("SaveStore::Snapshot");
+            Sburb *sburbInst = Sburb::GetInstance();
+
+            if (queuedBaseGeneration != baseGeneration)
+            {
+                StringSerialWriter out;
+                Serializer::Serialize(out);
+                snapshot.base = std::move(out.GetString());
+                queuedBaseGeneration = baseGeneration;
+            }
+
+            StringSerialWriter root;
+            Serializer::SerializeRoot(root);
+            snapshot.root = std::move(root.GetString());
+
+            snapshot.gameState = sburbInst->GetGameState();
+
+            std::unordered_map<Sprite *, std::string> spriteRooms;
+            for (const auto &room : sburbInst->GetRooms())
+            {
+                for (const auto &sprite : room.second->GetSprites())
+                    spriteRooms.emplace(sprite.get(), room.first);
+            }
+
+            snapshot.sprites.reserve(sburbInst->GetSprites().Size());
+            for (const auto &entry : sburbInst->GetSprites())
+            {
+                const std::shared_ptr<Sprite> &sprite = entry.second;
+                SpriteSnapshot spriteSnapshot;
+                spriteSnapshot.name = sprite->GetName();
+                spriteSnapshot.x = sprite->GetX();
+                spriteSnapshot.y = sprite->GetY();
+                spriteSnapshot.state = sprite->GetState();
+                if (auto character = std::dynamic_pointer_cast<Character>(sprite))
+                    spriteSnapshot.facing = character->GetFacing();
+
+                auto room = spriteRooms.find(sprite.get());
+                if (room != spriteRooms.end())
+                    spriteSnapshot.room = room->second;
+
+                snapshot.sprites.push_back(std::move(spriteSnapshot));
+            }
+
+            StringSerialWriter queues;
+            Serializer::SerializeActionQueues(queues);
+            snapshot.actionQueues = std::move(queues.GetString());
+        }
+
+        SaveWriter::getInstance().Queue(std::move(snapshot));
+        return true;
+    }
+
+    void SaveStore::InvalidateBase()
+    {
+        baseGeneration++;
+    }
+
+    void SaveStore::FinishWriting()
+    {
+        SaveWriter::getInstance().Finish();
+    }
+
+    bool SaveStore::Load(bool automatic, bool local)
+    {
+        // An autosave still on its way would otherwise be skipped for an older one
+        FinishWriting();
+
+        auto in = OpenSlot(automatic, local);
+        if (!in)
+            return false;
+
+        Header header;
+        std::string state;
+        if (!SBURB::ReadHeader(*in, header) || !ReadBody(*in, state))
+        {
+            GlobalLogger->Log(Logger::Error, std::string("The ") + (automatic ? "automatic" : "manual") + " save is corrupt or from another version.");
+            return false;
+        }
+
+        auto doc = std::make_shared<pugi::xml_document>();
+        pugi::xml_parse_result result = doc->load_buffer(state.data(), state.size());
+        if (result.status != pugi::status_ok)
+        {
+            GlobalLogger->Log(Logger::Error, std::string("Failed to parse save: ") + result.description());
+            return false;
+        }
+
+        return Serializer::LoadSavedState(doc);
+    }
+
+    bool SaveStore::Exists(bool automatic, bool local)
+    {
+        Header header;
+        return ReadHeader(automatic, local, header);
+    }
+
+    bool SaveStore::ReadHeader(bool automatic, bool local, Header &header)
+    {
+        if (SaveWriter::getInstance().FindHeader(automatic, local, header))
+            return true;
+
+        auto in = OpenSlot(automatic, local);
+        return in && SBURB::ReadHeader(*in, header);
+    }
+
+    void SaveStore::SetDirectory(const std::string &directory)
+    {
+        saveDirectory = directory;
+        if (!saveDirectory.empty() && saveDirectory.back() != '/')
+            saveDirectory += "/";
+    }
+
+    std::string SaveStore::GetSlotPath(bool automatic)
+    {
+        // The game name goes into the file name, keep it to something every file system takes
+        std::string name = Sburb::GetInstance()->GetName();
+        for (char &character : name)
+        {
+            if (!isalnum((unsigned char)character) && character != '-' && character != '_')
+                character = '_';
+        }
+
+        return saveDirectory + (name.empty() ? "game" : name) + (automatic ? "-auto" : "") + SAVE_EXTENSION;
+    }
+}
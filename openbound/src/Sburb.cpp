@@ -11,8 +11,16 @@
 #include "Serializer.h"
 #include "Parser.h"
 #include "CommandHandler.h"
+#include "Profiler.h"
+#include "AssetLoader.h"
+#include "SaveStore.h"
+#include <thread>
 
 constexpr float FADE_RATE = 0.1;
+// Cap on how many ticks we catch up in one go after a hitch (debugger, window drag, etc.)
+constexpr int MAX_TICKS_PER_UPDATE = 5;
+// sf::sleep is only as precise as the OS scheduler, so yield through the last stretch instead
+constexpr sf::Int64 SLEEP_SLACK_US = 2000;
 
 namespace SBURB
 {
@@ -27,7 +35,19 @@ namespace SBURB
         this->engineMode = "wander";
 
         this->FPS = 30;
+        this->renderFPS = 30;
+        this->tickTime = sf::seconds(1.0f / this->FPS);
+        this->renderTime = sf::seconds(1.0f / this->renderFPS);
+        this->tickAccumulator = sf::Time::Zero;
+        this->renderAccumulator = sf::Time::Zero;
         this->FPStimeObj = sf::Clock();
+        this->interpolate = false;
+        this->lastViewPos = Vector2();
+        this->headless = false;
+        this->tickCount = 0;
+        // Nothing is bound yet, and nothing was published or scheduled for the new tick count either
+        this->bindingEpoch = 1;
+        Signals::Clear();
 
         this->curRoom = nullptr;
         this->globalVolume = 1;
@@ -47,12 +67,12 @@ namespace SBURB
         this->bgm = nullptr;
         this->camera = Vector2();
 
-        this->buttons = {};
+        this->buttons.Clear();
         this->actionQueues = {};
-        this->effects = {};
-        this->hud = {};
-        this->sprites = {};
-        this->rooms = {};
+        this->effects.Clear();
+        this->hud.Clear();
+        this->sprites.Clear();
+        this->rooms.Clear();
         this->fonts = {};
         
         this->character = nullptr;
@@ -84,13 +104,17 @@ namespace SBURB
         AssetManager::ClearPaths();
         AssetManager::ClearMovies();
         AssetManager::ClearFonts();
+
+        this->replay.Close(this->tickCount);
+
+        SaveStore::FinishWriting();
     }
 
     void Sburb::PurgeState()
     {
-        this->rooms = {};
+        this->rooms.Clear();
 
-        this->sprites = {};
+        this->sprites.Clear();
 
         if (this->bgm)
         {
@@ -98,12 +122,12 @@ namespace SBURB
             this->bgm = nullptr;
         }
 
-        this->gameState = {};
+        this->gameState.Clear();
         this->globalVolume = 1;
-        this->hud = {};
-        this->sprites = {};
-        this->buttons = {};
-        this->effects = {};
+        this->hud.Clear();
+        this->sprites.Clear();
+        this->buttons.Clear();
+        this->effects.Clear();
         this->queue->SetCurrentAction(nullptr);
         this->actionQueues = {};
         this->chooser = std::make_shared<Chooser>();
@@ -123,18 +147,33 @@ namespace SBURB
 
     void Sburb::Update()
     {
-        sf::Int32 FPStime = FPStimeObj.getElapsedTime().asMilliseconds();
+        Profiler::getInstance().BeginFrame();
 
         // Event polling
         sf::Event event;
         while (window->pollEvent(event))
         {
+            if (window->hasFocus())
+                replay.RecordEvent(this->tickCount, event);
+
             inputHandler.Update(event, window->hasFocus());
 
             if (event.type == sf::Event::KeyPressed)
             {
                 if (event.key.code == sf::Keyboard::Escape)
                     window->close();
+
+                // Profiler hotkeys, F3 toggles the overlay and F4 dumps a trace next to the executable
+                if (event.key.code == sf::Keyboard::F3)
+                {
+                    bool show = !Profiler::getInstance().GetShowOverlay();
+                    Profiler::getInstance().SetEnabled(show);
+                    Profiler::getInstance().SetShowOverlay(show);
+                }
+                else if (event.key.code == sf::Keyboard::F4 && Profiler::IsEnabled())
+                {
+                    Profiler::getInstance().ExportTrace(GetExecutableDirectory() + "/trace.json");
+                }
             }
             else if (event.type == sf::Event::Closed)
             {
@@ -142,44 +181,128 @@ namespace SBURB
             }
         }
 
-        // FPS check
-        if (FPStime >= FPS)
+        // Upload whatever the loader threads finished, the state is parsed once they are all in
+        Serializer::UpdateLoading();
+
+        sf::Time elapsed = FPStimeObj.restart();
+
+        // Don't try to catch up on huge stalls, just drop the time.
+        if (elapsed > this->tickTime * (sf::Int64)MAX_TICKS_PER_UPDATE)
+        {
+            elapsed = this->tickTime * (sf::Int64)MAX_TICKS_PER_UPDATE;
+        }
+
+        this->tickAccumulator += elapsed;
+        this->renderAccumulator += elapsed;
+
+        // Fixed step simulation
+        while (this->tickAccumulator >= this->tickTime)
+        {
+            this->tickAccumulator -= this->tickTime;
+            this->Tick();
+        }
+
+        if (this->renderAccumulator >= this->renderTime)
         {
-            double delta = FPStimeObj.restart().asSeconds();
-            const double deltaCalculations = 1.0 / ((double)FPS - 10);
-            if (delta > deltaCalculations)
+            this->renderAccumulator %= this->renderTime;
+
+            // Render
+            if (this->shouldDraw)
             {
-                delta = deltaCalculations;
+                Render();
             }
+            // Loads halt drawing while the state is half built, only the progress goes up meanwhile
+            else if (Serializer::IsLoading())
+            {
+                DrawLoadingScreen();
+            }
+        }
+
+        Profiler::getInstance().EndFrame();
+
+        // Sleep until whichever of the next tick or the next frame comes first
+        SBURB_PROFILE_SCOPE("Sleep");
+        sf::Time untilTick = this->tickTime - this->tickAccumulator;
+        sf::Time untilRender = this->renderTime - this->renderAccumulator;
+        sf::Time wake = std::min(untilTick, untilRender);
 
-            // Run main update method for all objects
-            if (this->shouldUpdate)
+        while (window->isOpen())
+        {
+            sf::Time remaining = wake - FPStimeObj.getElapsedTime();
+            if (remaining <= sf::Time::Zero)
+                break;
+
+            if (remaining.asMicroseconds() > SLEEP_SLACK_US)
+                sf::sleep(remaining - sf::microseconds(SLEEP_SLACK_US));
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    void Sburb::Tick()
+    {
+        SBURB_PROFILE_SCOPE("Tick");
+
+        // Run main update method for all objects
+        if (this->shouldUpdate)
+        {
+            Signals::Advance(this->tickCount);
+
+            // Feed any recorded input due on this tick
+            sf::Event event;
+            while (replay.PollEvent(this->tickCount, event))
             {
-                //this->HandleAudio();
+                inputHandler.Update(event, true);
+            }
+
+            this->lastViewPos = this->viewPos;
+
+            //this->HandleAudio();
+            {
+                SBURB_PROFILE_SCOPE("HandleInputs");
                 this->HandleInputs();
+            }
+            {
+                SBURB_PROFILE_SCOPE("HandleHud");
                 this->HandleHud();
+            }
 
-                if (this->curRoom && !this->loadingRoom) {
-                    curRoom->Update();
-                }
+            if (this->curRoom && !this->loadingRoom) {
+                SBURB_PROFILE_SCOPE("Room::Update");
+                curRoom->Update();
+            }
 
+            {
+                SBURB_PROFILE_SCOPE("FocusCamera");
                 this->FocusCamera();
+            }
+            {
+                SBURB_PROFILE_SCOPE("HandleRoomChange");
                 this->HandleRoomChange();
+            }
 
+            {
+                SBURB_PROFILE_SCOPE("Chooser::Update");
                 this->chooser->Update();
+            }
+            {
+                SBURB_PROFILE_SCOPE("Dialoger::Update");
                 this->dialoger->Update();
+            }
 
+            {
+                SBURB_PROFILE_SCOPE("ChainAction");
                 this->ChainAction();
+            }
+            {
+                SBURB_PROFILE_SCOPE("UpdateWait");
                 this->UpdateWait();
             }
 
-            this->window->setView(this->view);
+            if (replay.IsHashing())
+                replay.WriteStateHash(this->tickCount, this->HashState());
 
-            // Render
-            if (this->shouldDraw)
-            {
-                Render();
-            }
+            this->tickCount++;
         }
     }
 
@@ -234,7 +357,7 @@ namespace SBURB
 
     void Sburb::HandleHud()
     {
-        for (auto obj : this->hud)
+        for (const auto &obj : this->hud)
         {
             obj.second->Update();
         }
@@ -264,8 +387,6 @@ namespace SBURB
         this->viewPos.x = std::max(0, std::min((int)round(this->camera.x / this->scale.x) * this->scale.x, this->curRoom->GetWidth() - this->viewSize.x));
         this->viewPos.y = std::max(0, std::min((int)round(this->camera.y / this->scale.y) * this->scale.y, this->curRoom->GetHeight() - this->viewSize.y));
 
-        // Move view
-        this->view.setCenter(sf::Vector2f(this->viewPos.x + this->viewSize.x / 2, this->viewPos.y + this->viewSize.y / 2));
     }
 
     void Sburb::HandleRoomChange()
@@ -295,6 +416,7 @@ namespace SBURB
                 this->curRoom = this->destRoom;
                 this->curRoom->Enter();
                 this->destRoom = nullptr;
+                this->UpdateResidency();
             }
             else
             {
@@ -308,6 +430,28 @@ namespace SBURB
         }
     }
 
+    void Sburb::UpdateResidency()
+    {
+        if (!this->curRoom || this->headless)
+            return;
+
+        std::vector<std::shared_ptr<Asset>> assets;
+        std::vector<std::string> neighbours;
+
+        this->curRoom->CollectAssets(assets);
+        this->curRoom->CollectNeighbours(neighbours);
+
+        for (auto &name : neighbours)
+        {
+            auto &room = this->rooms.Get(name);
+            if (room && room != this->curRoom)
+                room->CollectAssets(assets);
+        }
+
+        AssetManager::PinAssets(assets);
+        AssetManager::EnforceBudget();
+    }
+
     void Sburb::ChainAction()
     {
         if (this->queue->GetCurrentAction())
@@ -328,7 +472,7 @@ namespace SBURB
 
             if (queue->GetPaused())
             {
-                if ((queue->GetTrigger() && queue->GetTrigger()->CheckCompletion()))
+                if ((queue->GetTrigger() && queue->GetTrigger()->Evaluate()))
                 {
                     queue->SetPaused(false);
                     queue->SetTrigger(nullptr);
@@ -371,14 +515,14 @@ namespace SBURB
     {
         if (this->queue->GetTrigger())
         {
-            if (this->queue->GetTrigger()->CheckCompletion())
+            if (this->queue->GetTrigger()->Evaluate())
             {
                 this->queue->SetTrigger(nullptr);
             }
         }
         if (this->inputDisabled && this->inputDisabledTrigger)
         {
-            if (this->inputDisabledTrigger->CheckCompletion())
+            if (this->inputDisabledTrigger->Evaluate())
             {
                 this->inputDisabled = false;
             }
@@ -387,8 +531,22 @@ namespace SBURB
 
     void Sburb::Render()
     {
+        SBURB_PROFILE_SCOPE("Render");
+
         if (!this->playingMovie)
         {
+            // Move view, blending between the last two ticks if we render faster than we simulate
+            sf::Vector2f viewCenter((float)this->viewPos.x, (float)this->viewPos.y);
+            if (this->interpolate)
+            {
+                float alpha = this->tickAccumulator / this->tickTime;
+                viewCenter.x = this->lastViewPos.x + (this->viewPos.x - this->lastViewPos.x) * alpha;
+                viewCenter.y = this->lastViewPos.y + (this->viewPos.y - this->lastViewPos.y) * alpha;
+            }
+
+            this->view.setCenter(sf::Vector2f(std::round(viewCenter.x) + this->viewSize.x / 2, std::round(viewCenter.y) + this->viewSize.y / 2));
+            window->setView(this->view);
+
             window->clear(sf::Color(0, 0, 0, 255));
 
             BatchHandler::getInstance().Reset();
@@ -397,10 +555,20 @@ namespace SBURB
 
             // Render all objects
             if (this->curRoom)
+            {
+                SBURB_PROFILE_SCOPE("Render::Room");
+                sf::Vector2f viewSize = this->view.getSize();
+                BatchHandler::getInstance().SetCullRect(sf::FloatRect(this->view.getCenter() - viewSize / 2.f, viewSize));
                 window->draw(*curRoom);
+                BatchHandler::getInstance().ClearCullRect();
+            }
 
             if (this->fade > 0.1)
             {
+                // Anything still queued has to go out before the fade covers it
+                if (BatchHandler::getInstance().BatchExists())
+                    BatchHandler::getInstance().DrawBatch();
+
                 window->draw(fadeShape);
             }
 
@@ -420,8 +588,53 @@ namespace SBURB
             if (BatchHandler::getInstance().BatchExists())
                 BatchHandler::getInstance().DrawBatch();
 
-            window->display();
+            Profiler::getInstance().DrawOverlay(*window.GetWin());
+
+            {
+                SBURB_PROFILE_SCOPE("Display");
+                window->display();
+            }
+        }
+    }
+
+    void Sburb::DrawLoadingScreen()
+    {
+        SBURB_PROFILE_SCOPE("Render::Loading");
+
+        sf::RenderWindow &target = *window.GetWin();
+        sf::View oldView = target.getView();
+        target.setView(target.getDefaultView());
+        target.clear(sf::Color(0, 0, 0, 255));
+
+        AssetLoader &loader = AssetLoader::getInstance();
+        sf::Vector2f barSize(this->viewSize.x * 0.6f, 12);
+        sf::Vector2f barPos((this->viewSize.x - barSize.x) / 2, this->viewSize.y / 2);
+
+        sf::RectangleShape frame(barSize);
+        frame.setPosition(barPos);
+        frame.setFillColor(sf::Color(0, 0, 0, 200));
+        frame.setOutlineColor(sf::Color::White);
+        frame.setOutlineThickness(1);
+        target.draw(frame);
+
+        sf::RectangleShape bar(sf::Vector2f(barSize.x * loader.GetProgress(), barSize.y));
+        bar.setPosition(barPos);
+        bar.setFillColor(sf::Color::White);
+        target.draw(bar);
+
+        // The font may well be one of the things still loading
+        auto font = AssetManager::GetFontByName("SburbFont");
+        if (font && font->IsLoaded())
+        {
+            std::string status = "Loading " + this->description + " (" + std::to_string(loader.GetLoadedCount()) + "/" + std::to_string(loader.GetQueuedCount()) + ")";
+            sf::Text text(status, *font->GetAsset(), 12);
+            text.setPosition(barPos.x, barPos.y - 20);
+            text.setFillColor(sf::Color::White);
+            target.draw(text);
         }
+
+        target.display();
+        target.setView(oldView);
     }
 
     bool Sburb::Start()
@@ -443,6 +656,7 @@ namespace SBURB
             return false;
 
         // Start update loop
+        FPStimeObj.restart();
         while (window->isOpen())
         {
             Update();
@@ -451,12 +665,117 @@ namespace SBURB
         return true;
     }
 
+    bool Sburb::StartHeadless(uint32_t maxTicks)
+    {
+        this->headless = true;
+
+        if (maxTicks == 0 && !replay.IsPlaying())
+        {
+            GlobalLogger->Log(Logger::Error, "Headless runs need a tick count or an input log to replay.");
+            return false;
+        }
+
+        // Initialize room
+        if (!Serializer::LoadSerialFromXML("./levels/init.xml"))
+            return false;
+
+        // Run the simulation flat out, no pacing
+        sf::Clock benchmark;
+        while (this->shouldUpdate)
+        {
+            if (maxTicks != 0 ? this->tickCount >= maxTicks : replay.IsFinished(this->tickCount))
+                break;
+
+            Profiler::getInstance().BeginFrame();
+            Tick();
+            Profiler::getInstance().EndFrame();
+        }
+
+        float seconds = benchmark.getElapsedTime().asSeconds();
+        std::string result = "Simulated " + std::to_string(this->tickCount) + " ticks in " + std::to_string(seconds) + "s (" + std::to_string(seconds > 0 ? this->tickCount / seconds : 0) + " ticks/sec)";
+        GlobalLogger->Log(Logger::Info, result);
+
+        return true;
+    }
+
+    uint64_t Sburb::HashState()
+    {
+        // FNV-1a over everything the simulation can change
+        uint64_t hash = 14695981039346656037ULL;
+        auto hashBytes = [&hash](const void *data, size_t size)
+        {
+            const unsigned char *bytes = (const unsigned char *)data;
+            for (size_t i = 0; i < size; i++)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+        auto hashInt = [&hashBytes](int64_t value) { hashBytes(&value, sizeof(value)); };
+        auto hashString = [&hashBytes](const std::string &value) { hashBytes(value.c_str(), value.size() + 1); };
+
+        hashInt(this->tickCount);
+        hashString(this->curRoom ? this->curRoom->GetName() : "");
+        hashString(this->character ? this->character->GetName() : "");
+        hashString(this->engineMode);
+        hashInt(this->camera.x);
+        hashInt(this->camera.y);
+        hashInt((int64_t)(this->fade * 1000));
+        hashInt(this->inputDisabled);
+        hashInt(this->dialoger ? this->dialoger->GetTalking() : 0);
+        hashInt(this->chooser ? this->chooser->GetChoosing() : 0);
+
+        for (auto state : this->gameState.ToMap())
+        {
+            hashString(state.first);
+            hashString(state.second);
+        }
+
+        for (const auto &sprite : this->sprites)
+        {
+            if (!sprite.second)
+                continue;
+
+            hashString(sprite.first);
+            hashInt(sprite.second->GetX());
+            hashInt(sprite.second->GetY());
+
+            if (auto animation = sprite.second->GetAnimation())
+            {
+                hashString(animation->GetName());
+                hashInt(animation->GetCurrentFrame());
+            }
+        }
+
+        hashString(this->queue->GetCurrentAction() ? this->queue->GetCurrentAction()->GetCommand() : "");
+        for (const auto &queue : this->actionQueues)
+        {
+            hashString(queue->GetId());
+            hashString(queue->GetCurrentAction() ? queue->GetCurrentAction()->GetCommand() : "");
+            hashInt(queue->GetPaused());
+        }
+
+        return hash;
+    }
+
     // Getters
     double Sburb::GetFPS()
     {
         return this->FPS;
     }
 
+    void Sburb::SetTickRate(sf::Int32 ticksPerSecond)
+    {
+        this->FPS = std::max(1, ticksPerSecond);
+        this->tickTime = sf::seconds(1.0f / this->FPS);
+    }
+
+    void Sburb::SetRenderRate(sf::Int32 framesPerSecond)
+    {
+        this->renderFPS = std::max(1, framesPerSecond);
+        this->renderTime = sf::seconds(1.0f / this->renderFPS);
+    }
+
     std::string Sburb::GetName()
     {
         return name;
@@ -474,24 +793,29 @@ namespace SBURB
 
     void Sburb::SaveStateToStorage(std::string state, bool automatic, bool local)
     {
-        // TODO: NOT SUPPORTED YET
+        SaveStore::Save(state, automatic, local);
     }
 
     void Sburb::LoadStateFromStorage(bool automatic, bool local)
     {
-        // TODO: NOT SUPPORTED YET
+        SaveStore::Load(automatic, local);
     }
 
     bool Sburb::IsStateInStorage(bool automatic, bool local)
     {
-        // TODO: NOT SUPPORTED YET
-        return false;
+        return SaveStore::Exists(automatic, local);
     }
 
-    std::string Sburb::GetStateDescription(bool automatic)
+    std::string Sburb::GetStateDescription(bool automatic, bool local)
     {
-        // TODO: NOT SUPPORTED YET
-        return "";
+        SaveStore::Header header;
+        if (!SaveStore::ReadHeader(automatic, local, header))
+            return "";
+
+        std::time_t timestamp = header.timestamp;
+        char date[32] = "";
+        std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M", std::localtime(&timestamp));
+        return header.description + " (" + date + ")";
     }
 
     void Sburb::HaltUpdateProcess()
@@ -523,7 +847,8 @@ namespace SBURB
 
     void Sburb::SetDimensions(float width, float height)
     {
-        this->window->setSize(sf::Vector2u(width, height));
+        if (window.GetWin())
+            this->window->setSize(sf::Vector2u(width, height));
         this->viewSize = Vector2(width, height);
     }
 
@@ -547,6 +872,7 @@ namespace SBURB
             if (queue->GetId() == id)
             {
                 this->actionQueues.erase(this->actionQueues.begin() + i);
+                Signals::Publish(SignalQueues);
                 return;
             }
         }
@@ -560,6 +886,7 @@ namespace SBURB
             if (queue->HasGroup(group))
             {
                 this->actionQueues.erase(this->actionQueues.begin() + i);
+                Signals::Publish(SignalQueues);
                 i--;
             }
         }
@@ -668,6 +995,9 @@ namespace SBURB
 
     void Sburb::SetMouseCursor(sf::Cursor::Type newCursor)
     {
+        if (!window.GetWin())
+            return;
+
         sf::Cursor cursor;
         if (cursor.loadFromSystem(newCursor))
         {
@@ -704,7 +1034,7 @@ namespace SBURB
     {
         if (!this->curRoom->Contains(sprite))
         {
-            for (auto room : this->rooms)
+            for (const auto &room : this->rooms)
             {
                 if (room.second->Contains(sprite))
                 {
@@ -0,0 +1,162 @@
+#include "SerialWriter.h"
+
+#include <charconv>
+#include <zlib.h>
+
+// Sinks see chunks about this big, small enough to stay in cache
+constexpr size_t SERIAL_WRITER_BUFFER_SIZE = 64 * 1024;
+
+namespace SBURB
+{
+    SerialWriter::SerialWriter()
+        : written(0)
+    {
+        this->buffer.reserve(SERIAL_WRITER_BUFFER_SIZE);
+    }
+
+    SerialWriter::~SerialWriter()
+    {
+    }
+
+    void SerialWriter::Write(const char *data, size_t size)
+    {
+        this->written += size;
+
+        if (this->buffer.size() + size > SERIAL_WRITER_BUFFER_SIZE)
+        {
+            this->Flush();
+
+            // Too big to be worth buffering
+            if (size >= SERIAL_WRITER_BUFFER_SIZE)
+            {
+                this->Drain(data, size);
+                return;
+            }
+        }
+
+        this->buffer.append(data, size);
+    }
+
+    SerialWriter &SerialWriter::operator<<(int number)
+    {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        this->Write(digits, result.ptr - digits);
+        return *this;
+    }
+
+    SerialWriter &SerialWriter::operator<<(unsigned int number)
+    {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        this->Write(digits, result.ptr - digits);
+        return *this;
+    }
+
+    void SerialWriter::Flush()
+    {
+        if (this->buffer.empty())
+            return;
+
+        this->Drain(this->buffer.data(), this->buffer.size());
+        this->buffer.clear();
+    }
+
+    StringSerialWriter::~StringSerialWriter()
+    {
+    }
+
+    std::string &StringSerialWriter::GetString()
+    {
+        this->Flush();
+        return this->output;
+    }
+
+    void StringSerialWriter::Drain(const char *data, size_t size)
+    {
+        this->output.append(data, size);
+    }
+
+    FileSerialWriter::FileSerialWriter(const std::string &path)
+        : file(path, std::ios::binary | std::ios::trunc)
+    {
+    }
+
+    FileSerialWriter::~FileSerialWriter()
+    {
+        this->Close();
+    }
+
+    bool FileSerialWriter::Close()
+    {
+        if (!this->file.is_open())
+            return false;
+
+        this->Flush();
+        this->file.close();
+        return !this->file.fail();
+    }
+
+    void FileSerialWriter::Drain(const char *data, size_t size)
+    {
+        if (this->file.is_open())
+            this->file.write(data, size);
+    }
+
+    DeflateSerialWriter::DeflateSerialWriter(SerialWriter &sink, int level)
+        : sink(sink), stream(std::make_unique<z_stream_s>()), failed(false), finished(false)
+    {
+        this->failed = deflateInit(this->stream.get(), level) != Z_OK;
+    }
+
+    DeflateSerialWriter::~DeflateSerialWriter()
+    {
+        this->Finish();
+        deflateEnd(this->stream.get());
+    }
+
+    bool DeflateSerialWriter::Finish()
+    {
+        if (!this->finished)
+        {
+            this->Flush();
+            this->Deflate(nullptr, 0, Z_FINISH);
+            this->finished = true;
+        }
+
+        return !this->failed;
+    }
+
+    void DeflateSerialWriter::Drain(const char *data, size_t size)
+    {
+        this->Deflate(data, size, Z_NO_FLUSH);
+    }
+
+    void DeflateSerialWriter::Deflate(const char *data, size_t size, int flush)
+    {
+        if (this->failed || this->finished)
+            return;
+
+        char output[SERIAL_WRITER_BUFFER_SIZE / 4];
+
+        this->stream->next_in = (Bytef *)data;
+        this->stream->avail_in = size;
+
+        // Runs until zlib has taken all the input, and for the finish until it has nothing more to give
+        int result;
+        do
+        {
+            this->stream->next_out = (Bytef *)output;
+            this->stream->avail_out = sizeof(output);
+
+            result = deflate(this->stream.get(), flush);
+            if (result == Z_STREAM_ERROR)
+            {
+                this->failed = true;
+                return;
+            }
+
+            this->sink.Write(output, sizeof(output) - this->stream->avail_out);
+        } while (flush == Z_FINISH ? result != Z_STREAM_END : this->stream->avail_out == 0);
+    }
+}
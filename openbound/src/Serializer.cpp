@@ -3,12 +3,20 @@
 #include "Logger.h"
 #include "Parser.h"
 #include "AssetManager.h"
+#include "TextureAtlas.h"
 #include "AssetPath.h"
 #include "AssetMovie.h"
 #include "AssetGraphic.h"
 #include "AssetAudio.h"
 #include "AssetFont.h"
 #include "AssetText.h"
+#include "AssetLoader.h"
+#include "SaveStore.h"
+
+#include <algorithm>
+
+// How long the main thread may spend uploading finished assets each frame while a level streams in
+constexpr int LOAD_UPLOAD_BUDGET_MS = 8;
 
 namespace SBURB
 {
@@ -16,83 +24,132 @@ namespace SBURB
     static int loadingDepth = 0;
     static std::vector<pugi::xml_node> loadQueue;
     static pugi::xml_document templateDoc;
+    // Documents whose state is still waiting on their assets, the queued nodes point into them
+    static std::vector<std::shared_ptr<pugi::xml_document>> loadingDocs;
 
-    std::string Serializer::Serialize()
+    // Elements LoadSerialState hands to the parsers, in the order they have to be parsed
+    enum StateTag
     {
-        Sburb *sburbInst = Sburb::GetInstance();
+        ButtonTag,
+        SpriteTag,
+        CharacterTag,
+        FighterTag,
+        RoomTag,
+        GameStateTag
+    };
+    static const std::vector<const char *> stateTags = {"spritebutton", "sprite", "character", "fighter", "room", "gameState"};
 
-        std::string loadedFiles = "";
-        bool loadedFilesExist = false;
+    void Serializer::Serialize(SerialWriter &out)
+    {
+        Serializer::SerializeRoot(out);
+        Serializer::SerializeAssets(out);
+        Serializer::SerializeTemplates(out);
+        Serializer::SerializeHud(out);
+        Serializer::SerializeLooseObjects(out);
+        Serializer::SerializeRooms(out);
+        Serializer::SerializeGameState(out);
+        Serializer::SerializeActionQueues(out);
+
+        out << "\n</sburb>";
+    }
 
-        /*for (auto key : sburbInst->loadedFiles)
-        {
-            loadedFiles = loadedFiles + (loadedFilesExist ? "," : "") + key;
-            loadedFilesExist = true;
-        }*/
+    void Serializer::SerializeRoot(SerialWriter &out)
+    {
+        Sburb *sburbInst = Sburb::GetInstance();
 
         auto character = sburbInst->GetCharacter();
         auto bgm = sburbInst->GetBGM();
 
-        std::string output = "<sburb" +
-                             std::string(" char='") + character->GetName() +
-                             (bgm ? "' bgm='" + bgm->GetName() + (bgm->GetStartLoop() ? "," + std::to_string(bgm->GetStartLoop()) : "") : "") +
-                             (sburbInst->GetScale().x != 1 ? "' scale='" + sburbInst->GetScale().x : "") +
-                             (sburbInst->GetNextQueueId() > 0 ? "' nextQueueId='" + sburbInst->GetNextQueueId() : "") +
-                             (sburbInst->resourcePath != "" ? ("' resourcePath='" + sburbInst->resourcePath) : "") +
-                             (sburbInst->levelPath != "" ? ("' levelPath='" + sburbInst->levelPath) : "") +
-                             (loadedFilesExist ? ("' loadedFiles='" + loadedFiles) : "") +
-                             "'>\n";
-        output = Serializer::SerializeAssets(output);
-        output = Serializer::SerializeTemplates(output);
-        output = Serializer::SerializeHud(output);
-        output = Serializer::SerializeLooseObjects(output);
-        output = Serializer::SerializeRooms(output);
-        output = Serializer::SerializeGameState(output);
-        output = Serializer::SerializeActionQueues(output);
+        out << "<sburb char='" << character->GetName();
+        if (bgm)
+        {
+            out << "' bgm='" << bgm->GetName();
+            if (bgm->GetStartLoop())
+                out << "," << std::to_string(bgm->GetStartLoop());
+        }
+        if (sburbInst->GetScale().x != 1)
+            out << "' scale='" << sburbInst->GetScale().x;
+        if (sburbInst->GetNextQueueId() > 0)
+            out << "' nextQueueId='" << sburbInst->GetNextQueueId();
+        if (sburbInst->resourcePath != "")
+            out << "' resourcePath='" << sburbInst->resourcePath;
+        if (sburbInst->levelPath != "")
+            out << "' levelPath='" << sburbInst->levelPath;
 
-        output = output + "\n</sburb>";
+        bool loadedFilesExist = false;
+        for (const auto &key : sburbInst->loadedFiles)
+        {
+            out << (loadedFilesExist ? "," : "' loadedFiles='") << key;
+            loadedFilesExist = true;
+        }
 
-        return output;
+        out << "'>\n";
     }
 
-    std::string EncodeXML(std::string str)
+    std::string Serializer::Serialize()
     {
-        return replace(replace(replace(replace(str, "&", "&amp;"), "<", "&lt;"), ">", "&gt;"), "\"", "&quot;");
-    };
+        StringSerialWriter out;
+        Serializer::Serialize(out);
+        return std::move(out.GetString());
+    }
 
-    std::string Serializer::SerializeGameState(std::string output)
+    static void EncodeXML(SerialWriter &out, const std::string &str)
     {
-        output = output + "\n<gameState>\n";
-
-        for (auto state : Sburb::GetInstance()->GetGameState())
+        for (char character : str)
         {
-            output = output + "  <" + state.first + ">" + EncodeXML(state.second) + "</" + state.first + ">";
+            switch (character)
+            {
+            case '&':
+                out << "&amp;";
+                break;
+            case '<':
+                out << "&lt;";
+                break;
+            case '>':
+                out << "&gt;";
+                break;
+            case '"':
+                out << "&quot;";
+                break;
+            default:
+                out << character;
+                break;
+            }
         }
+    }
 
-        output = output + "\n</gameState>\n";
+    void Serializer::SerializeGameState(SerialWriter &out)
+    {
+        out << "\n<gameState>\n";
+
+        for (const auto &state : Sburb::GetInstance()->GetGameState())
+        {
+            out << "  <" << state.first << ">";
+            EncodeXML(out, state.second);
+            out << "</" << state.first << ">";
+        }
 
-        return output;
+        out << "\n</gameState>\n";
     }
 
-    std::string Serializer::SerializeActionQueues(std::string output)
+    void Serializer::SerializeActionQueues(SerialWriter &out)
     {
-        output = output + "<actionQueues>";
+        out << "<actionQueues>";
 
-        for (auto actionQueue : Sburb::GetInstance()->GetActionQueues())
+        for (const auto &actionQueue : Sburb::GetInstance()->GetActionQueues())
         {
             if (actionQueue->GetCurrentAction())
             {
-                output = actionQueue->Serialize(output);
+                actionQueue->Serialize(out);
             }
         }
-        output = output + "\n</actionQueues>\n";
 
-        return output;
+        out << "\n</actionQueues>\n";
     }
 
-    std::string Serializer::SerializeAssets(std::string output)
+    void Serializer::SerializeAssets(SerialWriter &out)
     {
-        output = output + "\n<assets>";
+        out << "\n<assets>";
         /*
         for (auto asset : assets)
         {
@@ -147,67 +204,61 @@ namespace SBURB
             output = output + "</asset>";
         }
         */
-        output = output + "\n</assets>\n";
-        output = output + "\n<effects>";
+        out << "\n</assets>\n";
+        out << "\n<effects>";
 
-        for (auto effect : Sburb::GetInstance()->GetEffects())
+        for (const auto &effect : Sburb::GetInstance()->GetEffects())
         {
-            output = effect.second->Serialize(output);
+            effect.second->Serialize(out);
         }
 
-        output = output + "\n</effects>\n";
-        return output;
+        out << "\n</effects>\n";
     }
 
-    std::string Serializer::SerializeTemplates(std::string output)
+    void Serializer::SerializeTemplates(SerialWriter &out)
     {
-        output = output + "\n<classes>";
+        out << "\n<classes>";
 
-        std::ostringstream serializeStream;
+        SerialXMLWriter writer(out);
 
-        for (auto templateNode : templateClasses)
+        for (const auto &templateNode : templateClasses)
         {
-            serializeStream.clear();
-            templateNode.second.print(serializeStream, "", pugi::format_raw);
-            output += serializeStream.str();
+            templateNode.second.print(writer, "", pugi::format_raw);
         }
 
-        output = output + "\n</classes>\n";
-        return output;
+        out << "\n</classes>\n";
     }
 
-    std::string Serializer::SerializeHud(std::string output)
+    void Serializer::SerializeHud(SerialWriter &out)
     {
-        output = output + "\n<hud>";
+        out << "\n<hud>";
 
-        for (auto content : Sburb::GetInstance()->GetHud())
+        for (const auto &content : Sburb::GetInstance()->GetHud())
         {
-            output = content.second->Serialize(output);
+            content.second->Serialize(out);
         }
 
-        output = Sburb::GetInstance()->GetDialoger()->Serialize(output);
+        Sburb::GetInstance()->GetDialoger()->Serialize(out);
 
-        auto animations = Sburb::GetInstance()->GetDialoger()->GetDialogSpriteLeft()->GetAnimations();
-        output = output + "\n<dialogsprites>";
+        out << "\n<dialogsprites>";
 
-        for (auto animation : animations)
+        for (const auto &animation : Sburb::GetInstance()->GetDialoger()->GetDialogSpriteLeft()->GetAnimations())
         {
-            output = animation.second->Serialize(output);
+            animation.second->Serialize(out);
         }
 
-        output = output + "\n</dialogsprites>";
-        output = output + "\n</hud>\n";
-        return output;
+        out << "\n</dialogsprites>";
+        out << "\n</hud>\n";
     }
 
-    std::string Serializer::SerializeLooseObjects(std::string output)
+    void Serializer::SerializeLooseObjects(SerialWriter &out)
     {
-        for (auto sprite : Sburb::GetInstance()->GetSprites())
+        for (const auto &sprite : Sburb::GetInstance()->GetSprites())
         {
             auto theSprite = sprite.second;
             bool contained = false;
 
-            for (auto room : Sburb::GetInstance()->GetRooms())
+            for (const auto &room : Sburb::GetInstance()->GetRooms())
             {
                 if (room.second->Contains(theSprite))
                 {
@@ -218,35 +269,31 @@ namespace SBURB
 
             if (!contained)
             {
-                output = theSprite->Serialize(output);
+                theSprite->Serialize(out);
             }
         }
 
-        for (auto button : Sburb::GetInstance()->GetButtons())
+        for (const auto &button : Sburb::GetInstance()->GetButtons())
         {
             auto theButton = button.second;
 
             if (!Sburb::GetInstance()->GetHud(theButton->GetName()))
             {
-                output = theButton->Serialize(output);
+                theButton->Serialize(out);
             }
         }
-
-        return output;
     }
 
-    std::string Serializer::SerializeRooms(std::string output)
+    void Serializer::SerializeRooms(SerialWriter &out)
     {
-        output = output + "\n<rooms>\n";
+        out << "\n<rooms>\n";
 
-        for (auto room : Sburb::GetInstance()->GetRooms())
+        for (const auto &room : Sburb::GetInstance()->GetRooms())
         {
-            output = room.second->Serialize(output);
+            room.second->Serialize(out);
         }
 
-        output = output + "\n</rooms>\n";
-
-        return output;
+        out << "\n</rooms>\n";
     }
 
     bool Serializer::LoadSerialFromXML(std::string path, bool keepOld)
@@ -254,19 +301,21 @@ namespace SBURB
         Sburb::GetInstance()->HaltUpdateProcess();
         path = Sburb::GetInstance()->levelPath + path;
 
-        // TODO: Add loadedFiles back in - it'll DEFINITELY break without.
-        /*if (keepOld && Sburb::GetInstance()->loadedFiles[path])
+        // A fresh load forgets everything, otherwise files already in only need parsing once
+        if (!keepOld)
         {
-            Sburb::GetInstance()->StartUpdateProcess();
-            return true;
+            Sburb::GetInstance()->loadedFiles.clear();
         }
-        else
+        else if (Sburb::GetInstance()->loadedFiles.count(path))
         {
-            //Sburb::GetInstance()->loadedFiles[path] = true;
-        }*/
+            // Nested dependency loads leave resuming to the outermost one
+            if (loadingDepth == 0 && !IsLoading())
+                Sburb::GetInstance()->StartUpdateProcess();
+            return true;
+        }
 
-        pugi::xml_document doc;
-        pugi::xml_parse_result initDocRes = doc.load_file(path.c_str());
+        auto doc = std::make_shared<pugi::xml_document>();
+        pugi::xml_parse_result initDocRes = doc->load_file(path.c_str());
 
         if (initDocRes.status != pugi::status_ok)
         {
@@ -275,8 +324,12 @@ namespace SBURB
             return false;
         }
 
-        // NOTE: IS THIS DOC KEPT ALIVE? MAYBE? PLAUSIBLY?
-        Serializer::LoadSerial(&doc, keepOld);
+        // Marked before parsing so dependency cycles stop here
+        Sburb::GetInstance()->loadedFiles.insert(path);
+
+        // Kept alive until the state has been parsed, which may be a few frames away
+        loadingDocs.push_back(doc);
+        return Serializer::LoadSerial(doc.get(), keepOld);
     }
 
     // IS THIS DOC KEPT ALIVE? PROBABLY NOT!
@@ -297,12 +350,26 @@ namespace SBURB
         AssetManager::ClearMovies();
     }
 
+    // Drops whatever an earlier load still has in flight, so none of it lands in the state that replaces it.
+    // The loader is drained rather than cut off, assets halfway through decoding can't be taken back.
+    static void CancelLoading(pugi::xml_document *keep)
+    {
+        AssetLoader::getInstance().Finish();
+        loadQueue.clear();
+
+        loadingDocs.erase(std::remove_if(loadingDocs.begin(), loadingDocs.end(), [keep](const std::shared_ptr<pugi::xml_document> &loadingDoc) {
+                              return loadingDoc.get() != keep;
+                          }),
+                          loadingDocs.end());
+    }
+
     bool Serializer::LoadSerial(pugi::xml_document *doc, bool keepOld)
     {
         pugi::xml_node rootNode = doc->child("sburb");
 
         if (!keepOld)
         {
+            CancelLoading(doc);
             templateDoc.reset();
             PurgeAssets();
             Sburb::GetInstance()->PurgeState();
@@ -321,6 +388,16 @@ namespace SBURB
             }
         }
 
+        // Saves remember which files they were built from, so those aren't parsed over them again
+        std::string loadedFiles = rootNode.attribute("loadedFiles").value();
+        if (loadedFiles != "")
+        {
+            for (auto file : split(loadedFiles, ","))
+            {
+                Sburb::GetInstance()->loadedFiles.insert(trim(file));
+            }
+        }
+
         std::string resourcePath = rootNode.attribute("resourcePath").value();
         if (resourcePath != "")
         {
@@ -352,11 +429,82 @@ namespace SBURB
         loadingDepth--;
         LoadSerialAssets(rootNode);
         loadQueue.push_back(rootNode);
-        LoadSerialState();
+
+        // The state needs every asset in place. Headless runs just wait, otherwise
+        // UpdateLoading picks it up once the loader drains and the game keeps drawing meanwhile.
+        if (loadingDepth == 0)
+        {
+            if (Sburb::GetInstance()->IsHeadless())
+                AssetLoader::getInstance().Finish();
+
+            if (!AssetLoader::getInstance().IsLoading())
+                FinishLoading();
+        }
 
         return true;
     }
 
+    bool Serializer::LoadSavedState(std::shared_ptr<pugi::xml_document> doc)
+    {
+        pugi::xml_node rootNode = doc->child("sburb");
+        if (!rootNode)
+        {
+            GlobalLogger->Log(Logger::Error, "Save has no sburb element.");
+            return false;
+        }
+
+        Sburb *sburbInst = Sburb::GetInstance();
+        sburbInst->HaltUpdateProcess();
+        CancelLoading(nullptr);
+
+        // Only the state goes, a full purge would have every asset decoded over again
+        std::string levelPath = sburbInst->levelPath;
+        sburbInst->PurgeState();
+        sburbInst->levelPath = levelPath;
+
+        // Files the save was built from that this session never loaded still have to bring their assets.
+        // Their state is parsed ahead of the save's, which then takes its place.
+        loadingDepth++;
+        for (auto file : split(rootNode.attribute("loadedFiles").value(), ","))
+        {
+            file = trim(file);
+            if (file == "" || sburbInst->loadedFiles.count(file))
+                continue;
+
+            // Stored with the level path in front, loading adds it back
+            if (file.compare(0, levelPath.length(), levelPath) == 0)
+                file = file.substr(levelPath.length());
+
+            LoadSerialFromXML(file, true);
+        }
+        loadingDepth--;
+
+        loadingDocs.push_back(doc);
+        return LoadSerial(doc.get(), true);
+    }
+
+    bool Serializer::IsLoading()
+    {
+        return !loadQueue.empty();
+    }
+
+    void Serializer::UpdateLoading()
+    {
+        if (loadQueue.empty() || loadingDepth != 0)
+            return;
+
+        if (AssetLoader::getInstance().Pump(sf::milliseconds(LOAD_UPLOAD_BUDGET_MS)))
+            FinishLoading();
+    }
+
+    void Serializer::FinishLoading()
+    {
+        TextureAtlas::PackPending();
+        LoadSerialState();
+        loadingDocs.clear();
+        Sburb::GetInstance()->UpdateResidency();
+    }
+
     bool Serializer::LoadDependencies(pugi::xml_node node)
     {
         pugi::xml_node dependenciesNode = node.child("dependencies");
@@ -396,20 +544,31 @@ namespace SBURB
 
             for (pugi::xml_node assetNode : assetNodes)
             {
-                /*if (!AssetManager::CheckIsLoaded(assetNode.attribute("name").value()))
-                {*/
+                if (!AssetManager::CheckIsLoaded(assetNode.attribute("name").value()))
+                {
                     LoadSerialAsset(assetNode);
-               // }
+                }
             }
         }
 
+        // Rooms only read their walkable maps through the mask, the loader builds that instead of a texture
+        for (pugi::xml_node roomNode : GetNestedChildren(&node, "room"))
+        {
+            auto walkableMap = AssetManager::GetGraphicByHandle(AssetManager::GetGraphicHandle(roomNode.attribute("walkableMap").as_string()));
+            if (walkableMap)
+                walkableMap->SetWalkable();
+        }
+
         return true;
     }
 
     void Serializer::LoadSerialAsset(pugi::xml_node node)
     {
         auto newAsset = ParseSerialAsset(node);
-        AssetManager::LoadAsset(newAsset);
+
+        // Decoding happens on the loader threads, anything already registered under this name stays
+        if (AssetManager::LoadAsset(newAsset))
+            AssetLoader::getInstance().Queue(newAsset);
     }
 
     std::shared_ptr<Asset> Serializer::ParseSerialAsset(pugi::xml_node node)
@@ -466,6 +625,8 @@ namespace SBURB
 
     void Serializer::LoadSerialState()
     {
+        SaveStore::InvalidateBase();
+
         // NOTE: USED TO HAVE A BIG LOOP HERE. NOT SURE WHAT TO DO ABOUT IT???
         // TODO: MAYBE ADD THE LOOP BACK?
 
@@ -478,12 +639,16 @@ namespace SBURB
             ParseTemplateClasses(input);
             ApplyTemplateClasses(input);
 
-            ParseButtons(input);
-            ParseSprites(input);
-            ParseCharacters(input);
-            ParseFighters(input);
-            ParseRooms(input);
-            ParseGameState(input);
+            // One walk finds everything, rooms come after the sprites they refer to
+            std::vector<std::vector<pugi::xml_node>> found;
+            GetNestedChildren(input, stateTags, found);
+
+            ParseButtons(found[ButtonTag]);
+            ParseSprites(found[SpriteTag]);
+            ParseCharacters(found[CharacterTag]);
+            ParseFighters(found[FighterTag]);
+            ParseRooms(found[RoomTag]);
+            ParseGameState(found[GameStateTag]);
 
             ParseHud(input);
             ParseEffects(input);
@@ -526,27 +691,29 @@ namespace SBURB
 
     void Serializer::ApplyTemplateClasses(pugi::xml_node node)
     {
-        for (auto templateNode : templateClasses)
+        if (templateClasses.empty())
+            return;
+
+        for (pugi::xml_node candidate : node.children())
         {
-            auto candidates = GetNestedChildren(&node, templateNode.second.name());
+            if (candidate.type() != pugi::node_element)
+                continue;
+
+            // Children first, whatever a template adds below was expanded when it was registered
+            ApplyTemplateClasses(candidate);
+
+            std::string candClass = candidate.attribute("class").as_string();
+            if (candClass == "")
+                continue;
 
-            for (pugi::xml_node candidate : candidates)
+            auto templateNode = templateClasses.find(candClass);
+            if (templateNode != templateClasses.end() && strcmp(templateNode->second.name(), candidate.name()) == 0)
             {
-                TryToApplyTemplate(templateNode.second, candidate);
+                Serializer::ApplyTemplate(templateNode->second, candidate);
             }
         }
     }
 
-    void Serializer::TryToApplyTemplate(pugi::xml_node templateNode, pugi::xml_node candidateNode)
-    {
-        std::string templateClass = templateNode.attribute("class").as_string();
-        std::string candClass = candidateNode.attribute("class").as_string();
-        if (candClass != "" && candClass == templateClass)
-        {
-            Serializer::ApplyTemplate(templateNode, candidateNode);
-        }
-    }
-
     void Serializer::ApplyTemplate(pugi::xml_node templateNode, pugi::xml_node candidateNode)
     {
         auto tempChildren = templateNode.children();
@@ -554,7 +721,7 @@ namespace SBURB
 
         for (auto tempAttribute : templateNode.attributes())
         {
-            if (candidateNode.attribute(tempAttribute.name()).as_string() == "")
+            if (!candidateNode.attribute(tempAttribute.name()))
             {
                 candidateNode.append_attribute(tempAttribute.name()).set_value(tempAttribute.as_string());
             }
@@ -566,10 +733,8 @@ namespace SBURB
         }
     }
 
-    void Serializer::ParseButtons(pugi::xml_node node)
+    void Serializer::ParseButtons(const std::vector<pugi::xml_node> &newButtons)
     {
-        auto newButtons = GetNestedChildren(&node, "spritebutton");
-
         for (pugi::xml_node curButton : newButtons)
         {
             auto newButton = Parser::ParseSpriteButton(curButton);
@@ -577,10 +742,8 @@ namespace SBURB
         }
     }
 
-    void Serializer::ParseSprites(pugi::xml_node node)
+    void Serializer::ParseSprites(const std::vector<pugi::xml_node> &newSprites)
     {
-        auto newSprites = GetNestedChildren(&node, "sprite");
-
         for (pugi::xml_node curSprite : newSprites)
         {
             auto newSprite = Parser::ParseSprite(curSprite);
@@ -607,10 +770,8 @@ namespace SBURB
         }
     }
 
-    void Serializer::ParseCharacters(pugi::xml_node node)
+    void Serializer::ParseCharacters(const std::vector<pugi::xml_node> &newChars)
     {
-        auto newChars = GetNestedChildren(&node, "character");
-
         for (pugi::xml_node curChar : newChars)
         {
             auto newChar = Parser::ParseCharacter(curChar);
@@ -619,10 +780,8 @@ namespace SBURB
         }
     }
 
-    void Serializer::ParseFighters(pugi::xml_node node)
+    void Serializer::ParseFighters(const std::vector<pugi::xml_node> &newFighters)
     {
-        auto newFighters = GetNestedChildren(&node, "fighter");
-
         for (pugi::xml_node curFighter : newFighters)
         {
             auto newFighter = Parser::ParseFighter(curFighter);
@@ -631,10 +790,8 @@ namespace SBURB
         }
     }
 
-    void Serializer::ParseRooms(pugi::xml_node node)
+    void Serializer::ParseRooms(const std::vector<pugi::xml_node> &newRooms)
     {
-        auto newRooms = GetNestedChildren(&node, "room");
-
         for (pugi::xml_node curRoom : newRooms)
         {
             auto newRoom = Parser::ParseRoom(curRoom);
@@ -642,10 +799,8 @@ namespace SBURB
         }
     }
 
-    void Serializer::ParseGameState(pugi::xml_node node)
+    void Serializer::ParseGameState(const std::vector<pugi::xml_node> &newGameStates)
     {
-        auto newGameStates = GetNestedChildren(&node, "gameState");
-
         for (pugi::xml_node curGameState : newGameStates)
         {
             auto children = curGameState.children();
@@ -655,8 +810,8 @@ namespace SBURB
                 if (child.type() == pugi::xml_node_type::node_pcdata)
                     continue;
 
-                std::string key = node.name();
-                std::string value = node.first_child().value();
+                std::string key = child.name();
+                std::string value = child.first_child().value();
                 Sburb::GetInstance()->SetGameState(key, value);
             }
         }
@@ -675,7 +830,11 @@ namespace SBURB
                 if (std::string(child.name()) == "spritebutton")
                 {
                     std::string name = child.attribute("name").as_string();
-                    Sburb::GetInstance()->SetHud(name, Sburb::GetInstance()->GetButton(name));
+                    auto button = Sburb::GetInstance()->GetButton(name);
+                    if (button)
+                    {
+                        Sburb::GetInstance()->SetHud(name, button);
+                    }
                 }
             }
         }
@@ -768,7 +927,7 @@ namespace SBURB
         }
         else if (Sburb::GetInstance()->GetCurrentRoom() == nullptr && Sburb::GetInstance()->GetCharacter() != nullptr)
         {
-            for (auto room : Sburb::GetInstance()->GetRooms())
+            for (const auto &room : Sburb::GetInstance()->GetRooms())
             {
                 if (room.second->Contains(Sburb::GetInstance()->GetCharacter()))
                 {
@@ -861,7 +1020,7 @@ namespace SBURB
         }
     }
 
-    void Serializer::SerialLoadRoomSprites(std::shared_ptr<Room> newRoom, std::vector<pugi::xml_node> roomSprites)
+    void Serializer::SerialLoadRoomSprites(std::shared_ptr<Room> newRoom, const std::vector<pugi::xml_node> &roomSprites)
     {
         for (pugi::xml_node curSprite : roomSprites)
         {
@@ -0,0 +1,89 @@
+#include "Signals.h"
+
+// Deadlines further out than this wrap around and wait for their lap
+constexpr uint32_t TIMER_WHEEL_SLOTS = 256;
+
+namespace SBURB
+{
+    static uint64_t signalClock = 0;
+    static uint64_t published[SignalCount] = {};
+
+    static std::vector<uint32_t> wheel[TIMER_WHEEL_SLOTS];
+    static uint32_t currentTick = 0;
+
+    void Signals::Publish(uint32_t signals)
+    {
+        signalClock++;
+
+        for (uint32_t i = 0; i < SignalCount; i++)
+        {
+            if (signals & (1u << i))
+                published[i] = signalClock;
+        }
+    }
+
+    uint64_t Signals::Now()
+    {
+        return signalClock;
+    }
+
+    bool Signals::Since(uint32_t signals, uint64_t stamp)
+    {
+        if (signals & SignalAlways)
+            return true;
+
+        for (uint32_t i = 0; i < SignalCount; i++)
+        {
+            if ((signals & (1u << i)) && published[i] > stamp)
+                return true;
+        }
+
+        return false;
+    }
+
+    void Signals::Schedule(uint32_t tick)
+    {
+        if (tick <= currentTick)
+        {
+            Publish(SignalTimer);
+            return;
+        }
+
+        wheel[tick % TIMER_WHEEL_SLOTS].push_back(tick);
+    }
+
+    void Signals::Advance(uint32_t tick)
+    {
+        // Catch up one slot at a time, a long stall can't skip a deadline
+        while (currentTick < tick)
+        {
+            currentTick++;
+            std::vector<uint32_t> &slot = wheel[currentTick % TIMER_WHEEL_SLOTS];
+            bool fired = false;
+
+            for (size_t i = 0; i < slot.size();)
+            {
+                if (slot[i] <= currentTick)
+                {
+                    slot[i] = slot.back();
+                    slot.pop_back();
+                    fired = true;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+
+            if (fired)
+                Publish(SignalTimer);
+        }
+    }
+
+    void Signals::Clear()
+    {
+        // Pending deadlines stay, a stale one only wakes triggers up for nothing.
+        // Stamps keep counting up, so everything looks changed to triggers that outlive this.
+        Publish(~0u & ~SignalAlways);
+    }
+}
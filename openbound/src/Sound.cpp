@@ -9,11 +9,17 @@ namespace SBURB
         this->type = "sound";
         this->audio = audio;
         this->asset = sf::Sound();
-        this->asset.setBuffer(*this->audio->GetAsset());
+        this->buffer = nullptr;
     }
 
     void Sound::Play(float pos)
     {
+        // Bound on demand, the buffer may have been evicted and reloaded since the last play
+        std::shared_ptr<sf::SoundBuffer> current = this->audio->GetAsset();
+        if (this->asset.getBuffer() != current.get())
+            this->asset.setBuffer(*current);
+        this->buffer = current;
+
         this->asset.setPlayingOffset(sf::seconds(pos));
 
         this->FixVolume();
@@ -28,11 +34,12 @@ namespace SBURB
     void Sound::Stop()
     {
         this->asset.stop();
+        this->buffer = nullptr;
     }
 
     bool Sound::Ended()
     {
-        return this->asset.getPlayingOffset() >= this->audio->GetAsset()->getDuration();
+        return !this->buffer || this->asset.getPlayingOffset() >= this->buffer->getDuration();
     }
 
     void Sound::FixVolume()
@@ -0,0 +1,195 @@
+#include "SpatialGrid.h"
+#include "Sprite.h"
+
+#include <algorithm>
+
+constexpr int GRID_MIN_CELL_SIZE = 64;
+constexpr int GRID_MAX_CELLS = 64; // Per axis, huge rooms get bigger cells instead
+
+namespace SBURB
+{
+    SpatialGrid::SpatialGrid(int width, int height)
+        : width(0), height(0), cellSize(GRID_MIN_CELL_SIZE), cols(1), rows(1), stamp(0)
+    {
+        this->Resize(width, height);
+    }
+
+    SpatialGrid::~SpatialGrid()
+    {
+        this->Clear();
+    }
+
+    void SpatialGrid::Resize(int width, int height)
+    {
+        this->width = std::max(width, 1);
+        this->height = std::max(height, 1);
+
+        int longest = std::max(this->width, this->height);
+        this->cellSize = std::max(GRID_MIN_CELL_SIZE, (longest + GRID_MAX_CELLS - 1) / GRID_MAX_CELLS);
+        this->cols = (this->width + this->cellSize - 1) / this->cellSize;
+        this->rows = (this->height + this->cellSize - 1) / this->cellSize;
+
+        this->cells.clear();
+        this->cells.resize(this->cols * this->rows);
+
+        for (auto &entry : this->entries)
+        {
+            entry.second.range = this->CellsFor(entry.first);
+            this->Link(&entry.second);
+        }
+    }
+
+    void SpatialGrid::Insert(std::shared_ptr<Sprite> sprite)
+    {
+        if (!sprite || this->Contains(sprite.get()))
+            return;
+
+        Entry &entry = this->entries[sprite.get()];
+        entry.sprite = sprite;
+        entry.range = this->CellsFor(sprite.get());
+        entry.order = this->entries.size() - 1;
+        entry.stamp = this->stamp;
+        this->Link(&entry);
+
+        sprite->AttachGrid(this);
+    }
+
+    bool SpatialGrid::Remove(Sprite *sprite)
+    {
+        auto entry = this->entries.find(sprite);
+        if (entry == this->entries.end())
+            return false;
+
+        this->Unlink(&entry->second);
+        sprite->DetachGrid(this);
+        this->entries.erase(entry);
+        return true;
+    }
+
+    void SpatialGrid::Move(Sprite *sprite)
+    {
+        auto entry = this->entries.find(sprite);
+        if (entry == this->entries.end())
+            return;
+
+        CellRange range = this->CellsFor(sprite);
+        if (range == entry->second.range)
+            return;
+
+        this->Unlink(&entry->second);
+        entry->second.range = range;
+        this->Link(&entry->second);
+    }
+
+    void SpatialGrid::Clear()
+    {
+        for (auto &entry : this->entries)
+        {
+            entry.second.sprite->DetachGrid(this);
+        }
+
+        this->entries.clear();
+        for (auto &cell : this->cells)
+        {
+            cell.clear();
+        }
+    }
+
+    void SpatialGrid::SetOrder(Sprite *sprite, int order)
+    {
+        auto entry = this->entries.find(sprite);
+        if (entry != this->entries.end())
+            entry->second.order = order;
+    }
+
+    void SpatialGrid::Query(int left, int top, int right, int bottom, std::vector<std::shared_ptr<Sprite>> &results)
+    {
+        CellRange range = this->CellsFor(left, top, right, bottom);
+
+        // Big sprites sit in several cells, the stamp makes sure each one is only reported once
+        this->stamp++;
+        this->found.clear();
+
+        for (int row = range.top; row <= range.bottom; row++)
+        {
+            for (int col = range.left; col <= range.right; col++)
+            {
+                for (Entry *entry : this->cells[row * this->cols + col])
+                {
+                    if (entry->stamp != this->stamp)
+                    {
+                        entry->stamp = this->stamp;
+                        this->found.push_back(entry);
+                    }
+                }
+            }
+        }
+
+        std::sort(this->found.begin(), this->found.end(), [](const Entry *a, const Entry *b) { return a->order < b->order; });
+
+        for (Entry *entry : this->found)
+        {
+            results.push_back(entry->sprite);
+        }
+    }
+
+    SpatialGrid::CellRange SpatialGrid::CellsFor(int left, int top, int right, int bottom) const
+    {
+        auto clampCol = [this](int x) { return std::clamp((int)std::floor((float)x / this->cellSize), 0, this->cols - 1); };
+        auto clampRow = [this](int y) { return std::clamp((int)std::floor((float)y / this->cellSize), 0, this->rows - 1); };
+
+        return {clampCol(left), clampRow(top), clampCol(right), clampRow(bottom)};
+    }
+
+    SpatialGrid::CellRange SpatialGrid::CellsFor(Sprite *sprite) const
+    {
+        // Collision box, as used by Sprite::Collides and Sprite::HitsPoint
+        int left = sprite->GetX() - sprite->GetWidth() / 2;
+        int top = sprite->GetY() - sprite->GetHeight() / 2;
+        int right = sprite->GetX() + sprite->GetWidth() / 2;
+        int bottom = sprite->GetY() + sprite->GetHeight() / 2;
+
+        // Current frame, as used by Sprite::IsVisuallyUnder
+        std::shared_ptr<Animation> animation = sprite->GetAnimation();
+        if (animation)
+        {
+            int animX = sprite->GetX() + animation->GetX();
+            int animY = sprite->GetY() + animation->GetY();
+            left = std::min(left, animX);
+            top = std::min(top, animY);
+            right = std::max(right, animX + animation->GetColSize());
+            bottom = std::max(bottom, animY + animation->GetRowSize());
+        }
+
+        return this->CellsFor(left, top, right, bottom);
+    }
+
+    void SpatialGrid::Link(Entry *entry)
+    {
+        for (int row = entry->range.top; row <= entry->range.bottom; row++)
+        {
+            for (int col = entry->range.left; col <= entry->range.right; col++)
+            {
+                this->cells[row * this->cols + col].push_back(entry);
+            }
+        }
+    }
+
+    void SpatialGrid::Unlink(Entry *entry)
+    {
+        for (int row = entry->range.top; row <= entry->range.bottom; row++)
+        {
+            for (int col = entry->range.left; col <= entry->range.right; col++)
+            {
+                std::vector<Entry *> &cell = this->cells[row * this->cols + col];
+                auto found = std::find(cell.begin(), cell.end(), entry);
+
+                if (found != cell.end())
+                {
+                    *found = cell.back();
+                    cell.pop_back();
+                }
+            }
+        }
+    }
+}
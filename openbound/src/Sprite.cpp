@@ -2,6 +2,7 @@
 #include "BatchHandler.h"
 #include "Serializer.h"
 #include "Sburb.h"
+#include "SpatialGrid.h"
 
 namespace SBURB
 {
@@ -16,7 +17,6 @@ namespace SBURB
         this->dy = dy;
         this->depthing = depthing;
         this->collidable = collidable;
-        this->queries = {};
 
         this->setPosition(this->x, this->y);
     }
@@ -31,6 +31,27 @@ namespace SBURB
             this->animation = this->animations[name];
             this->animation->Reset();
             this->state = name;
+            this->UpdateGrids();
+            Signals::Publish(SignalSprites);
+        }
+    }
+
+    void Sprite::AttachGrid(SpatialGrid* grid) {
+        if (std::find(this->grids.begin(), this->grids.end(), grid) == this->grids.end()) {
+            this->grids.push_back(grid);
+        }
+    }
+
+    void Sprite::DetachGrid(SpatialGrid* grid) {
+        auto found = std::find(this->grids.begin(), this->grids.end(), grid);
+        if (found != this->grids.end()) {
+            this->grids.erase(found);
+        }
+    }
+
+    void Sprite::UpdateGrids() {
+        for (SpatialGrid* grid : this->grids) {
+            grid->Move(this);
         }
     }
 
@@ -111,52 +132,46 @@ namespace SBURB
         return validActions;
     }
 
-    std::map<std::string, Vector2> Sprite::GetBoundaryQueries(int dx = 0, int dy = 0) {
+    void Sprite::GetBoundaryQueries(BoundaryQuery& query, int dx, int dy) {
         int spriteX = this->x + dx;
         int spriteY = this->y + dy;
         int w = this->width / 2;
         int h = this->height / 2;
 
-        this->queries["upRight"] = Vector2(spriteX + w, spriteY - h);
-        this->queries["upLeft"] = Vector2(spriteX - w, spriteY - h);
-        this->queries["downLeft"] = Vector2(spriteX - w, spriteY + h);
-        this->queries["downRight"] = Vector2(spriteX + w, spriteY + h);
-        this->queries["downMid"] = Vector2(spriteX, spriteY + h);
-        this->queries["upMid"] = Vector2(spriteX, spriteY - h);
-
-        return this->queries;
+        query.Set(BoundaryQuery::UpRight, spriteX + w, spriteY - h);
+        query.Set(BoundaryQuery::UpLeft, spriteX - w, spriteY - h);
+        query.Set(BoundaryQuery::DownLeft, spriteX - w, spriteY + h);
+        query.Set(BoundaryQuery::DownRight, spriteX + w, spriteY + h);
+        query.Set(BoundaryQuery::DownMid, spriteX, spriteY + h);
+        query.Set(BoundaryQuery::UpMid, spriteX, spriteY - h);
+        query.count = BoundaryQuery::BoxPointCount;
     }
 
-    std::string Sprite::Serialize(std::string output) {
-        int animationCount = 0;
-        for (auto anim : this->animations) {
-            animationCount++;
-        }
-
-        output = output + "\n<sprite " +
-            Serializer::SerializeAttribute("name", this->name) +
-            Serializer::SerializeAttribute("x", this->x) +
-            Serializer::SerializeAttribute("y", this->y) +
-            Serializer::SerializeAttribute("dx", this->dx) +
-            Serializer::SerializeAttribute("dy", this->dy) +
-            Serializer::SerializeAttribute("width", this->width) +
-            Serializer::SerializeAttribute("height", this->height) +
-            Serializer::SerializeAttribute("depthing", this->depthing) +
-            Serializer::SerializeAttribute("collidable", this->collidable) +
-            (animationCount > 1 ? "state='" + this->state + "' " : "") +
-            ">";
-
-        for (auto anim : this->animations) {
-            output = anim.second->Serialize(output);
+    void Sprite::Serialize(SerialWriter &out) {
+        out << "\n<sprite ";
+        Serializer::SerializeAttribute(out, "name", this->name);
+        Serializer::SerializeAttribute(out, "x", this->x);
+        Serializer::SerializeAttribute(out, "y", this->y);
+        Serializer::SerializeAttribute(out, "dx", this->dx);
+        Serializer::SerializeAttribute(out, "dy", this->dy);
+        Serializer::SerializeAttribute(out, "width", this->width);
+        Serializer::SerializeAttribute(out, "height", this->height);
+        Serializer::SerializeAttribute(out, "depthing", this->depthing);
+        Serializer::SerializeAttribute(out, "collidable", this->collidable);
+        if (this->animations.size() > 1) {
+            out << "state='" << this->state << "' ";
         }
+        out << ">";
 
-        for (auto action : this->actions) {
-            output = action->Serialize(output);
+        for (const auto &anim : this->animations) {
+            anim.second->Serialize(out);
         }
 
-        output = output + "\n</sprite>";
+        for (const auto &action : this->actions) {
+            action->Serialize(out);
+        }
 
-        return output;
+        out << "\n</sprite>";
     }
 
     std::shared_ptr<Sprite> Sprite::Clone(std::string newName) {
@@ -179,6 +194,14 @@ namespace SBURB
         return newSprite;
     }
 
+    sf::FloatRect Sprite::GetBounds() const
+    {
+        if (!this->animation)
+            return sf::FloatRect();
+
+        return getTransform().transformRect(this->animation->GetBounds());
+    }
+
     void Sprite::draw(sf::RenderTarget& target, sf::RenderStates states) const
     {
         if (this->animation) {
@@ -200,5 +223,7 @@ namespace SBURB
         else if (prop == "state") {
             return this->state;
         }
+
+        return "";
     }
 }
@@ -18,9 +18,9 @@ namespace SBURB
 
 		this->sheet = AssetManager::GetGraphicByName(sheetName);
 
-		for (int i = 0; i < (sheet->GetAsset()->getSize().x / this->width) * (sheet->GetAsset()->getSize().y / this->height); i++)
+		for (int i = 0; i < (sheet->GetSize().x / this->width) * (sheet->GetSize().y / this->height); i++)
 		{
-			this->AddAnimation(std::make_shared<Animation>("state" + i, sheetName, 0, 0, width, height, i, 1, "1000"));
+			this->AddAnimation(std::make_shared<Animation>("state" + std::to_string(i), sheetName, 0, 0, width, height, i, 1, "1000"));
 		}
 
 		this->StartAnimation("state0");
@@ -66,7 +66,7 @@ namespace SBURB
 				if (this->HitsPoint(x - this->width / 2, y - this->height / 2))
 				{
 					this->clicked = true;
-					std::string nextState = "state" + (stoi(this->animation->GetName().substr(5)) + 1);
+					std::string nextState = "state" + std::to_string(stoi(this->animation->GetName().substr(5)) + 1);
 
 					if (this->animations[nextState])
 					{
@@ -94,22 +94,23 @@ namespace SBURB
 		this->StartAnimation("state" + state);
 	}
 
-	std::string SpriteButton::Serialize(std::string output)
+	void SpriteButton::Serialize(SerialWriter &out)
 	{
-		output = output + "\n<spritebutton name='" + this->name +
-				 (this->x ? "' x='" + std::to_string(this->x) : "") +
-				 (this->y ? "' y='" + std::to_string(this->y) : "") +
-				 "' width='" + std::to_string(this->width) +
-				 "' height='" + std::to_string(this->height) +
-				 "' sheet='" + this->animation->GetSheet()->GetName() +
-				 "' >";
+		out << "\n<spritebutton name='" << this->name;
+		if (this->x)
+			out << "' x='" << this->x;
+		if (this->y)
+			out << "' y='" << this->y;
+		out << "' width='" << this->width <<
+			   "' height='" << this->height <<
+			   "' sheet='" << this->animation->GetSheet()->GetName() <<
+			   "' >";
 
 		if (this->action)
 		{
-			output = this->action->Serialize(output);
+			this->action->Serialize(out);
 		}
 
-		output = output + "</spritebutton>";
-		return output;
+		out << "</spritebutton>";
 	}
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "TextureAtlas.h"
+#include "Logger.h"
+#include "BatchHandler.h"
+
+#include <algorithm>
+
+// Anything bigger than this is usually a background or a walkable map, and is left on its own texture
+constexpr unsigned int MAX_ATLAS_ENTRY = 512;
+constexpr unsigned int MAX_PAGE_SIZE = 2048;
+// Gap between entries so neighbours don't bleed in when the view is scaled
+constexpr unsigned int ATLAS_PADDING = 2;
+
+namespace SBURB
+{
+    struct AtlasShelf
+    {
+        unsigned int y;
+        unsigned int height;
+        unsigned int usedWidth;
+    };
+
+    struct AtlasPage
+    {
+        std::shared_ptr<sf::Texture> texture;
+        std::vector<AtlasShelf> shelves;
+        unsigned int nextShelfY;
+    };
+
+    static std::vector<AtlasPage> pages;
+    static std::vector<std::shared_ptr<AssetGraphic>> pending;
+
+    static unsigned int GetPageSize()
+    {
+        return std::min(MAX_PAGE_SIZE, sf::Texture::getMaximumSize());
+    }
+
+    static bool TryPlace(AtlasPage &page, sf::Vector2u size, sf::Vector2u &position)
+    {
+        unsigned int pageSize = GetPageSize();
+        AtlasShelf *best = nullptr;
+
+        // Best fit: the shortest shelf that still has room
+        for (auto &shelf : page.shelves)
+        {
+            if (shelf.height >= size.y && shelf.usedWidth + size.x <= pageSize && (!best || shelf.height < best->height))
+            {
+                best = &shelf;
+            }
+        }
+
+        if (!best)
+        {
+            if (page.nextShelfY + size.y > pageSize)
+                return false;
+
+            page.shelves.push_back({page.nextShelfY, size.y, 0});
+            page.nextShelfY += size.y;
+            best = &page.shelves.back();
+        }
+
+        position = {best->usedWidth, best->y};
+        best->usedWidth += size.x;
+        return true;
+    }
+
+    void TextureAtlas::Register(std::shared_ptr<AssetGraphic> graphic)
+    {
+        sf::Vector2u size = graphic->GetSize();
+
+        if (size.x == 0 || size.y == 0 || size.x > MAX_ATLAS_ENTRY || size.y > MAX_ATLAS_ENTRY)
+            return;
+
+        pending.push_back(graphic);
+    }
+
+    void TextureAtlas::PackPending()
+    {
+        if (pending.empty())
+            return;
+
+        // Tallest first keeps the shelves tight
+        std::stable_sort(pending.begin(), pending.end(), [](const std::shared_ptr<AssetGraphic> &a, const std::shared_ptr<AssetGraphic> &b)
+                         { return a->GetSize().y > b->GetSize().y; });
+
+        unsigned int pageSize = GetPageSize();
+
+        for (auto &graphic : pending)
+        {
+            sf::Vector2u padded = graphic->GetSize() + sf::Vector2u(ATLAS_PADDING, ATLAS_PADDING);
+            sf::Vector2u position;
+            AtlasPage *target = nullptr;
+
+            for (auto &page : pages)
+            {
+                if (TryPlace(page, padded, position))
+                {
+                    target = &page;
+                    break;
+                }
+            }
+
+            if (!target)
+            {
+                AtlasPage page;
+                page.texture = std::make_shared<sf::Texture>();
+                page.nextShelfY = 0;
+
+                // Starts out transparent, the padding around entries is sampled when smoothing and has to be empty
+                sf::Image blank;
+                blank.create(pageSize, pageSize, sf::Color::Transparent);
+
+                if (!page.texture->loadFromImage(blank))
+                {
+                    GlobalLogger->Log(Logger::Error, "Failed to create texture atlas page.");
+                    break;
+                }
+
+                pages.push_back(page);
+                target = &pages.back();
+                TryPlace(*target, padded, position);
+            }
+
+            target->texture->update(*graphic->GetAsset(), position.x, position.y);
+            graphic->SetAtlasLocation(target->texture, position);
+
+            // Drawing goes through the page from now on, the graphic's own copy would only double the memory.
+            // It comes back from disk if anything asks for the texture itself.
+            graphic->Evict();
+        }
+
+        GlobalLogger->Log(Logger::Info, "Packed " + std::to_string(pending.size()) + " graphics into " + std::to_string(pages.size()) + " atlas pages.");
+        pending.clear();
+
+        // Recorded static batches may still point at the textures that were just dropped
+        BatchHandler::getInstance().InvalidateAllStatic();
+    }
+
+    void TextureAtlas::Clear()
+    {
+        pending.clear();
+        pages.clear();
+    }
+
+    int TextureAtlas::GetPageCount()
+    {
+        return pages.size();
+    }
+
+    size_t TextureAtlas::GetResidentSize()
+    {
+        size_t total = 0;
+        for (auto &page : pages)
+        {
+            sf::Vector2u size = page.texture->getSize();
+            total += (size_t)size.x * size.y * 4;
+        }
+
+        return total;
+    }
+}
@@ -1,6 +1,8 @@
 #include "Trigger.h"
 #include "Sburb.h"
 #include "EventFactory.h"
+#include "Profiler.h"
+#include "Signals.h"
 
 namespace SBURB {
     Trigger::Trigger(std::vector<std::string> info, std::shared_ptr<Action> action, std::shared_ptr<Trigger> followUp, bool shouldRestart, bool shouldDetonate, std::string op) {
@@ -12,13 +14,19 @@ namespace SBURB {
         this->op = op;
         this->waitFor = NULL;
 
+        this->signals = SignalNone;
+        this->checkedAt = 0;
+        this->completed = false;
+
         this->events = {};
         for (int i = 0; i < info.size(); i++) {
             std::string inf = trim(this->info[i]);
             std::vector<std::string> params = split(inf, ",");
             std::string type = params[0];
 
-            this->events.push_back(EventFactory::CreateEvent(type, inf));
+            std::shared_ptr<Event> event = EventFactory::CreateEvent(type, inf);
+            this->events.push_back(event);
+            this->signals |= event ? event->GetSignals() : SignalNone;
         }
         this->Reset();
     }
@@ -31,9 +39,61 @@ namespace SBURB {
         for (int i = 0; i < this->events.size(); i++) {
             this->events[i]->Reset();
         }
+
+        this->dirty = true;
+    }
+
+    void Trigger::Pause() {
+        for (int i = 0; i < this->events.size(); i++) {
+            this->events[i]->Pause();
+        }
+
+        if (this->followUp) {
+            this->followUp->Pause();
+        }
+    }
+
+    void Trigger::Resume() {
+        for (int i = 0; i < this->events.size(); i++) {
+            this->events[i]->Resume();
+        }
+
+        if (this->followUp) {
+            this->followUp->Resume();
+        }
+
+        this->dirty = true;
+    }
+
+    uint32_t Trigger::GetSignals() {
+        uint32_t signals = this->signals;
+
+        // Firing waits on a noActions trigger
+        if (this->action || this->waitFor) {
+            signals |= SignalQueues;
+        }
+
+        if (this->followUp) {
+            signals |= this->followUp->GetSignals();
+        }
+
+        return signals;
+    }
+
+    bool Trigger::Evaluate() {
+        if (this->dirty || Signals::Since(this->signals, this->checkedAt)) {
+            // Taken before checking, anything published while we do makes us dirty again
+            this->checkedAt = Signals::Now();
+            this->dirty = false;
+            this->completed = this->CheckCompletion();
+        }
+
+        return this->completed;
     }
 
     bool Trigger::CheckCompletion() {
+        SBURB_PROFILE_COUNT(TriggerEvaluations, 1);
+
         if (this->op == "AND") {
             bool result = true;
             
@@ -95,11 +155,13 @@ namespace SBURB {
 
             return result;
         }
+
+        return false;
     }
 
     bool Trigger::TryToTrigger() {
         if (this->waitFor) {
-            if (this->waitFor->CheckCompletion()) {
+            if (this->waitFor->Evaluate()) {
                 this->waitFor = nullptr;
             }
             else {
@@ -107,7 +169,10 @@ namespace SBURB {
             }
         }
 
-        if (this->CheckCompletion()) {
+        if (this->Evaluate()) {
+            // Still true next tick unless something changes, so look again like polling used to
+            this->dirty = true;
+
             if (this->action) {
                 std::shared_ptr<ActionQueue> result = Sburb::GetInstance()->PerformAction(this->action);
 
@@ -131,31 +196,34 @@ namespace SBURB {
 
             return this->shouldDetonate;
         }
+
+        return false;
     }
 
-    std::string Trigger::Serialize(std::string output) {
-        std::string newOutput = output + "\n<trigger" +
-            (this->shouldRestart ? " restart='true'" : "") +
-            (this->shouldDetonate ? " detonate='true'" : "") +
-            (this->op != "" ? " operator='" + this->op + "'" : "") +
-            ">";
+    void Trigger::Serialize(SerialWriter &out) {
+        out << "\n<trigger";
+        if (this->shouldRestart)
+            out << " restart='true'";
+        if (this->shouldDetonate)
+            out << " detonate='true'";
+        if (this->op != "")
+            out << " operator='" << this->op << "'";
+        out << ">";
         for (int i = 0; i < this->info.size(); i++) {
             if (this->events[i]->canSerialize) {
-                newOutput = newOutput + "<args>" + escape(this->events[i]->Serialize().c_str()) + "</args>";
+                out << "<args>" << escape(this->events[i]->Serialize().c_str()) << "</args>";
             }
             else {
-                newOutput = newOutput + "<args>" + escape(this->info[i].c_str()) + "</args>";
+                out << "<args>" << escape(this->info[i].c_str()) << "</args>";
             }
         }
         if (this->action) {
-            newOutput = this->action->Serialize(newOutput);
+            this->action->Serialize(out);
         }
         if (this->followUp) {
-            newOutput = this->followUp->Serialize(newOutput);
+            this->followUp->Serialize(out);
         }
 
-        newOutput = newOutput + "\n</trigger>";
-
-        return newOutput;
+        out << "\n</trigger>";
     }
 }
\ No newline at end of file
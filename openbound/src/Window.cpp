@@ -5,6 +5,7 @@ namespace SBURB
 {
     Window::Window()
     {
+        this->win = nullptr;
         this->title = "";
         this->size = {0, 0};
     }
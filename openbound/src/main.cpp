@@ -1,18 +1,82 @@
 #include <Common.h>
 #include <Sburb.h>
 #include <Logger.h>
+#include <Profiler.h>
+#include <AssetManager.h>
+
+#include <cstring>
 
 using namespace SBURB;
 
-int main()
+// Usage: openbound [--headless] [--ticks N] [--record log.txt] [--replay log.txt] [--hash-log hashes.txt] [--trace trace.json] [--memory-budget MB]
+int main(int argc, char **argv)
 {
     Sburb mainGame = Sburb();
-  
-    if (!mainGame.Start())
+
+    bool headless = false;
+    uint32_t maxTicks = 0;
+    std::string tracePath = "";
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+
+        if (strcmp(argv[i], "--headless") == 0)
+        {
+            headless = true;
+        }
+        else if (strcmp(argv[i], "--ticks") == 0 && hasValue)
+        {
+            maxTicks = std::stoul(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--record") == 0 && hasValue)
+        {
+            if (!mainGame.GetReplay().StartRecording(argv[++i]))
+                return -1;
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && hasValue)
+        {
+            if (!mainGame.GetReplay().LoadRecording(argv[++i]))
+                return -1;
+        }
+        else if (strcmp(argv[i], "--hash-log") == 0 && hasValue)
+        {
+            if (!mainGame.GetReplay().OpenHashLog(argv[++i]))
+                return -1;
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && hasValue)
+        {
+            tracePath = argv[++i];
+            Profiler::getInstance().SetEnabled(true);
+        }
+        else if (strcmp(argv[i], "--memory-budget") == 0 && hasValue)
+        {
+            AssetManager::SetMemoryBudget((size_t)std::stoul(argv[++i]) * 1024 * 1024);
+        }
+        else
+        {
+            GlobalLogger->Log(Logger::Warning, std::string("Unknown argument: ") + argv[i]);
+        }
+    }
+
+    if (headless)
+    {
+        mainGame.SetHeadless(true);
+
+        if (!mainGame.StartHeadless(maxTicks))
+        {
+            GlobalLogger->Log(Logger::Error, "Failed to run headless simulation.");
+            return -1;
+        }
+    }
+    else if (!mainGame.Start())
     {
         GlobalLogger->Log(Logger::Error, "Failed to initialize game object.");
         return -1;
     }
 
+    if (tracePath != "")
+        Profiler::getInstance().ExportTrace(tracePath);
+
     return 0;
-}
\ No newline at end of file
+}